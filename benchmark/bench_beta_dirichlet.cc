@@ -0,0 +1,183 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_dirichlet.hpp>
+#include <ziggurat_gamma.hpp>
+
+#include "jsf.hpp"
+
+
+// Each measurement generates this many numbers in total.
+constexpr std::size_t number_count = 10000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_numbers)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_numbers();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / double(number_count);
+    result.mean = double(sum) / double(number_count);
+    return result;
+}
+
+template<typename T>
+T sum_buffer(std::vector<T> const& buffer)
+{
+    T sum = 0;
+    for (T x : buffer) {
+        sum += x;
+    }
+    return sum;
+}
+
+// Composes a Dirichlet vector of gamma numbers from given distributions,
+// one distribution object per component.
+template<typename Gamma, typename T, typename Engine>
+void compose_dirichlet(
+    std::vector<T>& out,
+    std::size_t count,
+    std::vector<Gamma>& gammas,
+    Engine& engine
+)
+{
+    auto const dim = gammas.size();
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto const vec = out.data() + i * dim;
+
+        T sum = 0;
+        for (std::size_t k = 0; k < dim; k++) {
+            vec[k] = gammas[k](engine);
+            sum += vec[k];
+        }
+        for (std::size_t k = 0; k < dim; k++) {
+            vec[k] /= sum;
+        }
+    }
+}
+
+template<typename T, typename Engine>
+void run_beta(char const* name, T alpha, T beta)
+{
+    Engine engine;
+    std::gamma_distribution<T> std_x{alpha};
+    std::gamma_distribution<T> std_y{beta};
+    cxx::ziggurat_beta_distribution<T> zig_beta{alpha, beta};
+    std::vector<T> buffer(number_count);
+
+    std::cout << name << " std       " << measure([&] {
+        T sum = 0;
+        for (std::size_t i = 0; i < number_count; i++) {
+            auto const x = std_x(engine);
+            auto const y = std_y(engine);
+            sum += x / (x + y);
+        }
+        return sum;
+    }) << '\n';
+    std::cout << name << " ziggurat  " << measure([&] {
+        T sum = 0;
+        for (std::size_t i = 0; i < number_count; i++) {
+            sum += zig_beta(engine);
+        }
+        return sum;
+    }) << '\n';
+    std::cout << name << " generate  " << measure([&] {
+        zig_beta.generate(buffer.begin(), buffer.end(), engine);
+        return sum_buffer(buffer);
+    }) << '\n';
+}
+
+template<typename T, typename Engine>
+void run_dirichlet(char const* name, std::vector<T> const& alpha)
+{
+    Engine engine;
+
+    std::vector<std::gamma_distribution<T>> std_gammas;
+    std::vector<cxx::ziggurat_gamma_distribution<T>> zig_gammas;
+    for (auto const a : alpha) {
+        std_gammas.emplace_back(a);
+        zig_gammas.emplace_back(a);
+    }
+    cxx::dirichlet_generator<T> dirichlet{alpha};
+
+    auto const count = number_count / alpha.size();
+    std::vector<T> buffer(count * alpha.size());
+
+    std::cout << name << " std       " << measure([&] {
+        compose_dirichlet(buffer, count, std_gammas, engine);
+        return sum_buffer(buffer);
+    }) << '\n';
+    std::cout << name << " ziggurat  " << measure([&] {
+        compose_dirichlet(buffer, count, zig_gammas, engine);
+        return sum_buffer(buffer);
+    }) << '\n';
+    std::cout << name << " generate  " << measure([&] {
+        dirichlet.generate(buffer.data(), count, engine);
+        return sum_buffer(buffer);
+    }) << '\n';
+}
+
+// mixed_alpha returns concentrations cycling through values below and above
+// one, like the posterior of a topic model with sparse counts.
+template<typename T>
+std::vector<T> mixed_alpha(std::size_t dim)
+{
+    std::vector<T> alpha(dim);
+    for (std::size_t k = 0; k < dim; k++) {
+        alpha[k] = T(0.1) + T(k % 8);
+    }
+    return alpha;
+}
+
+int main()
+{
+    std::cout << "beta<double> a=2 b=5\n";
+    run_beta<double, std::mt19937_64>("MT64", 2, 5);
+    run_beta<double, jsf64>("JSF ", 2, 5);
+    std::cout << '\n';
+
+    std::cout << "beta<double> a=0.5 b=0.5\n";
+    run_beta<double, jsf64>("JSF ", 0.5, 0.5);
+    std::cout << '\n';
+
+    for (std::size_t k : {std::size_t(3), std::size_t(100), std::size_t(10000)}) {
+        std::cout << "dirichlet<double> K=" << k << " mixed\n";
+        run_dirichlet<double, std::mt19937_64>("MT64", mixed_alpha<double>(k));
+        run_dirichlet<double, jsf64>("JSF ", mixed_alpha<double>(k));
+        std::cout << '\n';
+
+        std::cout << "dirichlet<float> K=" << k << " mixed\n";
+        run_dirichlet<float, jsf64>("JSF ", mixed_alpha<float>(k));
+        std::cout << '\n';
+    }
+
+    std::cout << "dirichlet<double> K=10000 symmetric 0.1\n";
+    run_dirichlet<double, jsf64>("JSF ", std::vector<double>(10000, 0.1));
+    std::cout << '\n';
+
+    std::cout << "dirichlet<double> K=10000 symmetric 2\n";
+    run_dirichlet<double, jsf64>("JSF ", std::vector<double>(10000, 2.0));
+}
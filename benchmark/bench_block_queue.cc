@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_buffer.hpp>
+
+
+constexpr std::size_t queue_block_size = 4096;
+constexpr std::size_t queue_block_count = 64;
+constexpr std::size_t consumed_blocks = 4096;
+
+// measure returns the total consumption throughput in numbers per second.
+__attribute__((noinline))
+double measure(std::size_t producer_count, std::size_t consumer_count)
+{
+    using clock = std::chrono::steady_clock;
+
+    cxx::normal_block_queue<double> queue{0, producer_count, queue_block_size, queue_block_count};
+    std::atomic<std::ptrdiff_t> remaining{std::ptrdiff_t(consumed_blocks)};
+    std::vector<double> sums(consumer_count * 8);
+
+    auto consumer = [&](std::size_t id) {
+        double sum = 0;
+        while (remaining.fetch_sub(1) > 0) {
+            auto const block = queue.pop();
+            for (double z : block) {
+                sum += z;
+            }
+        }
+        sums[id * 8] = sum;
+    };
+
+    auto start_time = clock::now();
+
+    std::vector<std::thread> consumers;
+    for (std::size_t i = 0; i < consumer_count; i++) {
+        consumers.emplace_back(consumer, i);
+    }
+    for (auto& thread : consumers) {
+        thread.join();
+    }
+
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    return double(consumed_blocks * queue_block_size) / elapsed_time.count();
+}
+
+int main()
+{
+    std::size_t const max_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::size_t const producer_count = std::max(std::size_t(1), max_threads / 2);
+
+    std::vector<std::size_t> consumer_counts;
+    for (std::size_t consumers = 1; consumers < max_threads; consumers *= 2) {
+        consumer_counts.push_back(consumers);
+    }
+    consumer_counts.push_back(max_threads);
+
+    std::cout << producer_count << " producers\n";
+    std::cout << "consumers\tMnumbers/s\n";
+
+    for (auto consumers : consumer_counts) {
+        std::cout << consumers << '\t' << measure(producer_count, consumers) * 1e-6 << '\n';
+    }
+}
@@ -0,0 +1,133 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_process.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t path_count = 20000;
+
+struct measurement_result
+{
+    double rate;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.rate << " paths/s\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_squares)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_squares();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.rate = path_count / elapsed_time.count();
+    result.mean = double(sum) / path_count;
+    return result;
+}
+
+// Naive per-path incremental construction with a scalar normal call per
+// step. The mean of W(T)^2 is reported.
+template<typename T, typename Normal, typename Engine>
+T naive_paths(std::vector<T>& out, std::vector<T> const& times, Normal& normal, Engine& engine)
+{
+    auto const n = times.size();
+
+    T sum = 0;
+    for (std::size_t p = 0; p < path_count; p++) {
+        auto const path = out.data() + p * n;
+        T w = 0;
+        T prev_time = 0;
+        for (std::size_t k = 0; k < n; k++) {
+            w += std::sqrt(times[k] - prev_time) * normal(engine);
+            path[k] = w;
+            prev_time = times[k];
+        }
+        sum += w * w;
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+T generator_paths(
+    std::vector<T>& out,
+    cxx::brownian_path_generator<T>& brownian,
+    Engine& engine
+)
+{
+    brownian.generate(out.data(), path_count, engine);
+
+    auto const last = out.data() + (brownian.point_count() - 1) * path_count;
+
+    T sum = 0;
+    for (std::size_t p = 0; p < path_count; p++) {
+        sum += last[p] * last[p];
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+void run(char const* name, std::vector<T> const& times)
+{
+    Engine engine;
+    std::vector<T> buffer(path_count * times.size());
+
+    std::normal_distribution<T> std_normal;
+    cxx::ziggurat_normal_distribution<T> normal;
+    cxx::brownian_path_generator<T> incremental{times, cxx::brownian_construction::incremental};
+    cxx::brownian_path_generator<T> bridge{times, cxx::brownian_construction::bridge};
+
+    std::cout << name << " std          " << measure([&] {
+        return naive_paths(buffer, times, std_normal, engine);
+    }) << '\n';
+    std::cout << name << " naive        " << measure([&] {
+        return naive_paths(buffer, times, normal, engine);
+    }) << '\n';
+    std::cout << name << " incremental  " << measure([&] {
+        return generator_paths(buffer, incremental, engine);
+    }) << '\n';
+    std::cout << name << " bridge       " << measure([&] {
+        return generator_paths(buffer, bridge, engine);
+    }) << '\n';
+}
+
+// uniform_grid returns step_count equally spaced times ending at 1.
+template<typename T>
+std::vector<T> uniform_grid(std::size_t step_count)
+{
+    std::vector<T> times(step_count);
+    for (std::size_t k = 0; k < step_count; k++) {
+        times[k] = T(k + 1) / T(step_count);
+    }
+    return times;
+}
+
+int main()
+{
+    for (std::size_t step_count : {std::size_t(252), std::size_t(1024)}) {
+        std::cout << "double steps=" << step_count << '\n';
+        run<double, std::mt19937_64>("MT64", uniform_grid<double>(step_count));
+        run<double, jsf64>("JSF ", uniform_grid<double>(step_count));
+        std::cout << '\n';
+
+        std::cout << "float steps=" << step_count << '\n';
+        run<float, jsf64>("JSF ", uniform_grid<float>(step_count));
+        std::cout << '\n';
+    }
+}
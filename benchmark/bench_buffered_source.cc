@@ -0,0 +1,70 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <ziggurat.hpp>
+#include <ziggurat_buffer.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr int generation_count = 10000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F gen)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = decltype(gen())(0);
+
+    for (int i = 0; i < generation_count; i++) {
+        sum += gen();
+    }
+
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / generation_count;
+    result.mean = sum / generation_count;
+    return result;
+}
+
+template<typename T, typename Engine>
+void run(char const* name)
+{
+    Engine engine;
+    cxx::ziggurat_normal_distribution<T> normal;
+    cxx::buffered_normal_source<T, Engine> source;
+
+    std::cout << name << " operator()  " << measure([&] { return normal(engine); }) << '\n';
+    std::cout << name << " buffered    " << measure([&] { return source(); }) << '\n';
+}
+
+int main()
+{
+    std::cout << "double\n";
+    run<double, std::mt19937_64>("MT64");
+    run<double, std::mt19937>("MT32");
+    run<double, jsf64>("JSF ");
+    std::cout << '\n';
+    std::cout << "float\n";
+    run<float, std::mt19937_64>("MT64");
+    run<float, std::mt19937>("MT32");
+    run<float, jsf64>("JSF ");
+}
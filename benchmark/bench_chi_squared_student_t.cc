@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_gamma.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t generation_count = 10000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_numbers)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_numbers();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / generation_count;
+    result.mean = double(sum) / generation_count;
+    return result;
+}
+
+template<typename Dist, typename Engine>
+typename Dist::result_type sum_calls(Dist& dist, Engine& engine)
+{
+    typename Dist::result_type sum = 0;
+    for (std::size_t i = 0; i < generation_count; i++) {
+        sum += dist(engine);
+    }
+    return sum;
+}
+
+template<typename StdDist, typename ZigDist, typename Engine>
+void run(char const* name, typename StdDist::result_type n)
+{
+    using T = typename StdDist::result_type;
+
+    Engine engine;
+    StdDist std_dist{n};
+    ZigDist zig_dist{n};
+    std::vector<T> buffer(generation_count);
+
+    std::cout << name << " std       " << measure([&] { return sum_calls(std_dist, engine); }) << '\n';
+    std::cout << name << " ziggurat  " << measure([&] { return sum_calls(zig_dist, engine); }) << '\n';
+    std::cout << name << " generate  " << measure([&] {
+        zig_dist.generate(buffer.begin(), buffer.end(), engine);
+        T sum = 0;
+        for (T x : buffer) {
+            sum += x;
+        }
+        return sum;
+    }) << '\n';
+}
+
+int main()
+{
+    for (double n : {1.0, 2.0, 3.0, 30.0}) {
+        std::cout << "chi_squared<double> n=" << n << '\n';
+        run<std::chi_squared_distribution<double>, cxx::ziggurat_chi_squared_distribution<double>, std::mt19937_64>("MT64", n);
+        run<std::chi_squared_distribution<double>, cxx::ziggurat_chi_squared_distribution<double>, jsf64>("JSF ", n);
+        std::cout << '\n';
+    }
+    for (double n : {1.0, 2.0, 3.0, 30.0}) {
+        std::cout << "student_t<double> n=" << n << '\n';
+        run<std::student_t_distribution<double>, cxx::ziggurat_student_t_distribution<double>, std::mt19937_64>("MT64", n);
+        run<std::student_t_distribution<double>, cxx::ziggurat_student_t_distribution<double>, jsf64>("JSF ", n);
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,100 @@
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_complex.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t sample_count = 10000000;
+
+struct measurement_result
+{
+    double rate;
+    double power;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.rate * 1e-6 << " Msamples/s\t" << result.power;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_power)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto power = sum_power();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.rate = sample_count / elapsed_time.count();
+    result.power = double(power) / sample_count;
+    return result;
+}
+
+template<typename T>
+double sum_norm(std::vector<std::complex<T>> const& buffer)
+{
+    double sum = 0;
+    for (auto const& z : buffer) {
+        sum += double(std::norm(z));
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+void run(char const* name)
+{
+    Engine engine;
+    std::normal_distribution<T> std_normal{0, T(std::sqrt(0.5))};
+    cxx::ziggurat_complex_normal_distribution<T> complex_normal;
+    std::vector<std::complex<T>> buffer(sample_count);
+
+    std::cout << name << " std pair      " << measure([&] {
+        for (auto& z : buffer) {
+            auto const re = std_normal(engine);
+            auto const im = std_normal(engine);
+            z = {re, im};
+        }
+        return sum_norm(buffer);
+    }) << '\n';
+    std::cout << name << " ziggurat      " << measure([&] {
+        for (auto& z : buffer) {
+            z = complex_normal(engine);
+        }
+        return sum_norm(buffer);
+    }) << '\n';
+    std::cout << name << " generate      " << measure([&] {
+        complex_normal.generate(buffer.data(), buffer.data() + buffer.size(), engine);
+        return sum_norm(buffer);
+    }) << '\n';
+
+    // The buffer holds unit-power noise from above, so the output power is
+    // 1 + 1 / 10.
+    std::cout << name << " add 10 dB     " << measure([&] {
+        cxx::add_noise_at_snr(buffer.data(), buffer.size(), T(10), T(1), engine);
+        return sum_norm(buffer);
+    }) << '\n';
+}
+
+int main()
+{
+    std::cout << "complex<double>\n";
+    run<double, std::mt19937_64>("MT64");
+    run<double, jsf64>("JSF ");
+    std::cout << '\n';
+    std::cout << "complex<float>\n";
+    run<float, std::mt19937_64>("MT64");
+    run<float, std::mt19937>("MT32");
+    run<float, jsf64>("JSF ");
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_discrete.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t generation_count = 10000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_numbers)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_numbers();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / generation_count;
+    result.mean = double(sum) / generation_count;
+    return result;
+}
+
+// Textbook sampler: uniform integers within 10 sigma of the center accepted
+// with probability exp(-(x - c)^2 / 2 sigma^2).
+template<typename Engine>
+long uniform_rejection(Engine& engine, double center, double sigma)
+{
+    std::uniform_int_distribution<long> candidate{
+        long(std::floor(center - 10 * sigma)),
+        long(std::ceil(center + 10 * sigma))
+    };
+    std::uniform_real_distribution<double> uniform;
+
+    for (;;) {
+        auto const x = candidate(engine);
+        auto const dx = double(x) - center;
+        if (uniform(engine) < std::exp(-dx * dx / (2 * sigma * sigma))) {
+            return x;
+        }
+    }
+}
+
+template<typename Engine>
+void run(char const* name, double sigma)
+{
+    double const center = 0.25;
+
+    Engine engine;
+    cxx::ziggurat_discrete_gaussian_distribution<long> dist{center, sigma};
+    std::vector<long> buffer(generation_count);
+
+    std::cout << name << " uniform   " << measure([&] {
+        long sum = 0;
+        for (std::size_t i = 0; i < generation_count; i++) {
+            sum += uniform_rejection(engine, center, sigma);
+        }
+        return sum;
+    }) << '\n';
+    std::cout << name << " ziggurat  " << measure([&] {
+        long sum = 0;
+        for (std::size_t i = 0; i < generation_count; i++) {
+            sum += dist(engine);
+        }
+        return sum;
+    }) << '\n';
+    std::cout << name << " generate  " << measure([&] {
+        dist.generate(buffer.begin(), buffer.end(), engine);
+        long sum = 0;
+        for (long x : buffer) {
+            sum += x;
+        }
+        return sum;
+    }) << '\n';
+}
+
+int main()
+{
+    for (double sigma : {1.0, 3.2, 16.0, 128.0, 256.0, 257.0, 1024.0, 65536.0}) {
+        std::cout << "sigma=" << sigma << '\n';
+        run<std::mt19937_64>("MT64", sigma);
+        run<jsf64>("JSF ", sigma);
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_gamma.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t generation_count = 10000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_gammas)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_gammas();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / generation_count;
+    result.mean = double(sum) / generation_count;
+    return result;
+}
+
+template<typename Dist, typename Engine>
+typename Dist::result_type sum_calls(Dist& dist, Engine& engine)
+{
+    typename Dist::result_type sum = 0;
+    for (std::size_t i = 0; i < generation_count; i++) {
+        sum += dist(engine);
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+void run(char const* name, T alpha)
+{
+    Engine engine;
+    std::gamma_distribution<T> std_gamma{alpha};
+    cxx::ziggurat_gamma_distribution<T> zig_gamma{alpha};
+    std::vector<T> buffer(generation_count);
+
+    std::cout << name << " std       " << measure([&] { return sum_calls(std_gamma, engine); }) << '\n';
+    std::cout << name << " ziggurat  " << measure([&] { return sum_calls(zig_gamma, engine); }) << '\n';
+    std::cout << name << " generate  " << measure([&] {
+        zig_gamma.generate(buffer.begin(), buffer.end(), engine);
+        T sum = 0;
+        for (T x : buffer) {
+            sum += x;
+        }
+        return sum;
+    }) << '\n';
+}
+
+int main()
+{
+    for (double alpha : {0.5, 2.0, 10.0}) {
+        std::cout << "double alpha=" << alpha << '\n';
+        run<double, std::mt19937_64>("MT64", alpha);
+        run<double, jsf64>("JSF ", alpha);
+        std::cout << '\n';
+    }
+    for (float alpha : {0.5F, 2.0F, 10.0F}) {
+        std::cout << "float alpha=" << alpha << '\n';
+        run<float, std::mt19937_64>("MT64", alpha);
+        run<float, jsf64>("JSF ", alpha);
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,114 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_process.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t path_count = 20000;
+
+struct measurement_result
+{
+    double rate;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.rate << " paths/s\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_finals)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_finals();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.rate = path_count / elapsed_time.count();
+    result.mean = double(sum) / path_count;
+    return result;
+}
+
+// Naive per-step simulation with a scalar normal call and std::exp.
+template<typename T, typename Engine>
+T naive_paths(std::vector<T>& out, std::size_t step_count, Engine& engine)
+{
+    T const s0 = 100;
+    T const dt = T(1) / T(step_count);
+    T const drift = (T(0.05) - T(0.2) * T(0.2) / 2) * dt;
+    T const vol = T(0.2) * std::sqrt(dt);
+    cxx::ziggurat_normal_distribution<T> normal;
+
+    T sum = 0;
+    for (std::size_t p = 0; p < path_count; p++) {
+        auto const path = out.data() + p * (step_count + 1);
+        path[0] = s0;
+        for (std::size_t t = 1; t <= step_count; t++) {
+            path[t] = path[t - 1] * std::exp(drift + vol * normal(engine));
+        }
+        sum += path[step_count];
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+T generator_paths(
+    std::vector<T>& out, std::size_t step_count, cxx::path_layout layout, Engine& engine
+)
+{
+    cxx::gbm_path_generator<T> gbm{100, T(0.05), T(0.2), T(1) / T(step_count), step_count, layout};
+    gbm.generate(out.data(), path_count, engine);
+
+    T sum = 0;
+    for (std::size_t p = 0; p < path_count; p++) {
+        sum += layout == cxx::path_layout::path_major
+            ? out[p * gbm.point_count() + step_count]
+            : out[step_count * path_count + p];
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+void run(char const* name, std::size_t step_count)
+{
+    Engine engine;
+    std::vector<T> buffer(path_count * (step_count + 1));
+
+    std::cout << name << " naive       " << measure([&] {
+        return naive_paths(buffer, step_count, engine);
+    }) << '\n';
+    std::cout << name << " path-major  " << measure([&] {
+        return generator_paths(buffer, step_count, cxx::path_layout::path_major, engine);
+    }) << '\n';
+    std::cout << name << " step-major  " << measure([&] {
+        return generator_paths(buffer, step_count, cxx::path_layout::step_major, engine);
+    }) << '\n';
+}
+
+int main()
+{
+    for (std::size_t step_count : {std::size_t(252), std::size_t(1024)}) {
+        std::cout << "double steps=" << step_count << '\n';
+        run<double, std::mt19937_64>("MT64", step_count);
+        run<double, jsf64>("JSF ", step_count);
+        std::cout << '\n';
+
+        std::cout << "float steps=" << step_count << '\n';
+        run<float, std::mt19937_64>("MT64", step_count);
+        run<float, jsf64>("JSF ", step_count);
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_half_normal.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t generation_count = 10000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_samples)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_samples();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / generation_count;
+    result.mean = double(sum) / generation_count;
+    return result;
+}
+
+template<typename T>
+T sum_buffer(std::vector<T> const& buffer)
+{
+    T sum = 0;
+    for (T x : buffer) {
+        sum += x;
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+void run(char const* name)
+{
+    Engine engine;
+    cxx::ziggurat_normal_distribution<T> normal;
+    cxx::ziggurat_half_normal_distribution<T> half_normal;
+    std::vector<T> buffer(generation_count);
+
+    std::cout << name << " abs(normal)     " << measure([&] {
+        T sum = 0;
+        for (std::size_t i = 0; i < generation_count; i++) {
+            sum += std::fabs(normal(engine));
+        }
+        return sum;
+    }) << '\n';
+    std::cout << name << " half_normal     " << measure([&] {
+        T sum = 0;
+        for (std::size_t i = 0; i < generation_count; i++) {
+            sum += half_normal(engine);
+        }
+        return sum;
+    }) << '\n';
+    std::cout << name << " abs(generate)   " << measure([&] {
+        normal.generate(buffer.begin(), buffer.end(), engine);
+        for (T& x : buffer) {
+            x = std::fabs(x);
+        }
+        return sum_buffer(buffer);
+    }) << '\n';
+    std::cout << name << " generate        " << measure([&] {
+        half_normal.generate(buffer.begin(), buffer.end(), engine);
+        return sum_buffer(buffer);
+    }) << '\n';
+}
+
+int main()
+{
+    std::cout << "double\n";
+    run<double, std::mt19937_64>("MT64");
+    run<double, std::mt19937>("MT32");
+    run<double, jsf64>("JSF ");
+    std::cout << '\n';
+    std::cout << "float\n";
+    run<float, std::mt19937_64>("MT64");
+    run<float, std::mt19937>("MT32");
+    run<float, jsf64>("JSF ");
+}
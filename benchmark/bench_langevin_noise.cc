@@ -0,0 +1,130 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_langevin.hpp>
+
+#include "jsf.hpp"
+
+
+struct measurement_result
+{
+    double time;
+    double energy;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/component\t" << result.energy;
+}
+
+// measure runs the O step once and reports the time per velocity component
+// and the mean kinetic energy per component, which should be close to
+// (1 - c1^2) kT / 2 for particles starting at rest.
+template<typename T, typename F>
+__attribute__((noinline))
+measurement_result measure(std::vector<T>& velocity, std::vector<T> const& mass, F o_step)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::fill(velocity.begin(), velocity.end(), T(0));
+
+    auto start_time = clock::now();
+    o_step();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    auto const dimension = velocity.size() / mass.size();
+    double energy = 0;
+    for (std::size_t i = 0; i < velocity.size(); i++) {
+        energy += double(mass[i / dimension]) * double(velocity[i]) * double(velocity[i]) / 2;
+    }
+
+    measurement_result result;
+    result.time = elapsed_time.count() / double(velocity.size());
+    result.energy = energy / double(velocity.size());
+    return result;
+}
+
+template<typename T, typename Engine>
+void run(char const* name, std::size_t particle_count, std::size_t dimension)
+{
+    Engine engine;
+    cxx::ziggurat_normal_distribution<T> normal;
+
+    T const kT = 1;
+    T const friction = 1;
+    T const dt = T(0.5);
+    T const c1 = std::exp(-friction * dt);
+    T const c2 = std::sqrt(-std::expm1(-2 * friction * dt));
+
+    // Masses cycle through a few values; the scale of a particle is
+    // sqrt(kT / m).
+    std::vector<T> mass(particle_count);
+    std::vector<T> scale(particle_count);
+    for (std::size_t p = 0; p < particle_count; p++) {
+        mass[p] = T(1 + p % 4);
+        scale[p] = std::sqrt(kT / mass[p]);
+    }
+
+    auto const count = dimension * particle_count;
+    std::vector<T> velocity(count);
+
+    std::cout << name << " scalar    " << measure(velocity, mass, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            velocity[i] = c1 * velocity[i] + c2 * scale[i / dimension] * normal(engine);
+        }
+    }) << '\n';
+
+    // Two passes: the whole noise array is generated and then applied.
+    {
+        std::vector<T> noise(count);
+        std::cout << name << " two-pass  " << measure(velocity, mass, [&] {
+            normal.generate(noise.begin(), noise.end(), engine);
+            for (std::size_t i = 0; i < count; i++) {
+                velocity[i] = c1 * velocity[i] + c2 * scale[i / dimension] * noise[i];
+            }
+        }) << '\n';
+    }
+
+    std::cout << name << " fused     " << measure(velocity, mass, [&] {
+        if (dimension == 3) {
+            cxx::apply_langevin_noise3(velocity.data(), scale.data(), particle_count, c1, c2, engine);
+        } else {
+            cxx::apply_langevin_noise(velocity.data(), scale.data(), particle_count, c1, c2, engine);
+        }
+    }) << '\n';
+}
+
+int main()
+{
+    std::size_t const small = 1000000;
+    std::size_t const large = 100000000;
+
+    std::cout << "double particles=" << small << '\n';
+    run<double, std::mt19937_64>("MT64 flat", small, 1);
+    run<double, jsf64>("JSF  flat", small, 1);
+    run<double, jsf64>("JSF  aos3", small, 3);
+    std::cout << '\n';
+
+    std::cout << "float particles=" << small << '\n';
+    run<float, jsf64>("JSF  flat", small, 1);
+    run<float, jsf64>("JSF  aos3", small, 3);
+    std::cout << '\n';
+
+    // The AoS arrays of 100M double particles with a noise array for the
+    // two-pass method do not fit in a small machine, so the large run uses
+    // the flat layout for double.
+    std::cout << "double particles=" << large << '\n';
+    run<double, jsf64>("JSF  flat", large, 1);
+    std::cout << '\n';
+
+    std::cout << "float particles=" << large << '\n';
+    run<float, jsf64>("JSF  flat", large, 1);
+    run<float, jsf64>("JSF  aos3", large, 3);
+}
@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_multivariate.hpp>
+
+#include "jsf.hpp"
+
+
+// Each measurement generates this many numbers in total.
+constexpr std::size_t number_count = 20000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/vec\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(std::size_t vector_count, F sum_vectors)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_vectors();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / double(vector_count);
+    result.mean = double(sum) / double(number_count);
+    return result;
+}
+
+// Naive approach: a matrix-vector product per standard normal vector.
+template<typename T, typename Engine>
+T naive_vectors(
+    std::vector<T>& out,
+    std::size_t count,
+    std::vector<T> const& mean,
+    std::vector<T> const& factor,
+    Engine& engine
+)
+{
+    auto const n = mean.size();
+    cxx::ziggurat_normal_distribution<T> normal;
+    std::vector<T> z(n);
+
+    for (std::size_t k = 0; k < count; k++) {
+        normal.generate(z.begin(), z.end(), engine);
+
+        auto const x = out.data() + k * n;
+        for (std::size_t i = 0; i < n; i++) {
+            T sum = mean[i];
+            for (std::size_t j = 0; j <= i; j++) {
+                sum += factor[i * n + j] * z[j];
+            }
+            x[i] = sum;
+        }
+    }
+
+    T sum = 0;
+    for (T x : out) {
+        sum += x;
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+void run(char const* name, std::size_t n)
+{
+    Engine engine;
+
+    std::vector<T> mean(n, 1);
+    std::vector<T> covariance(n * n);
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t j = 0; j < n; j++) {
+            covariance[i * n + j] = T(std::pow(0.5, std::fabs(double(i) - double(j))));
+        }
+    }
+    cxx::multivariate_normal<T> mvn{mean, covariance};
+
+    auto const count = number_count / n;
+    std::vector<T> buffer(count * n);
+
+    std::cout << name << " naive    " << measure(count, [&] {
+        return naive_vectors(buffer, count, mean, mvn.cholesky_factor(), engine);
+    }) << '\n';
+    std::cout << name << " blocked  " << measure(count, [&] {
+        mvn.generate(buffer.data(), count, engine);
+        T sum = 0;
+        for (T x : buffer) {
+            sum += x;
+        }
+        return sum;
+    }) << '\n';
+}
+
+int main()
+{
+    for (std::size_t n : {std::size_t(5), std::size_t(20), std::size_t(100), std::size_t(500)}) {
+        std::cout << "double n=" << n << '\n';
+        run<double, std::mt19937_64>("MT64", n);
+        run<double, jsf64>("JSF ", n);
+        std::cout << '\n';
+
+        std::cout << "float n=" << n << '\n';
+        run<float, jsf64>("JSF ", n);
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_ranges.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t generation_count = 10000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_normals)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_normals();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / generation_count;
+    result.mean = double(sum) / generation_count;
+    return result;
+}
+
+template<typename T, typename Engine>
+void run(char const* name)
+{
+    Engine engine;
+    cxx::ziggurat_normal_distribution<T> normal;
+    std::vector<T> buffer(generation_count);
+
+    std::cout << name << " operator()  " << measure([&] {
+        T sum = 0;
+        for (std::size_t i = 0; i < generation_count; i++) {
+            sum += normal(engine);
+        }
+        return sum;
+    }) << '\n';
+
+    std::cout << name << " generate    " << measure([&] {
+        normal.generate(buffer.begin(), buffer.end(), engine);
+        T sum = 0;
+        for (T z : buffer) {
+            sum += z;
+        }
+        return sum;
+    }) << '\n';
+
+    std::cout << name << " normal_view " << measure([&] {
+        T sum = 0;
+        for (T z : cxx::normal_view<Engine, T>(engine) | std::views::take(generation_count)) {
+            sum += z;
+        }
+        return sum;
+    }) << '\n';
+
+    std::cout << name << " coroutine   " << measure([&] {
+        T sum = 0;
+        for (T z : cxx::generate_normals<T>(engine, {}, generation_count)) {
+            sum += z;
+        }
+        return sum;
+    }) << '\n';
+}
+
+int main()
+{
+    std::cout << "double\n";
+    run<double, std::mt19937_64>("MT64");
+    run<double, jsf64>("JSF ");
+    std::cout << '\n';
+    std::cout << "float\n";
+    run<float, std::mt19937_64>("MT64");
+    run<float, jsf64>("JSF ");
+}
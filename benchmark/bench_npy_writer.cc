@@ -0,0 +1,36 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <ziggurat_npy.hpp>
+
+
+constexpr std::uint64_t element_count = 1 << 27;
+
+template<typename T>
+__attribute__((noinline))
+double measure(std::string const& path)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    cxx::write_normal_npy<T>(path, {element_count}, 123);
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    std::remove(path.c_str());
+
+    return double(element_count * sizeof(T)) / elapsed_time.count();
+}
+
+int main(int argc, char** argv)
+{
+    std::string const path = argc > 1 ? argv[1] : "bench_npy_writer.npy";
+
+    std::cout << "float64  " << measure<double>(path) * 1e-9 << " GB/s\n";
+    std::cout << "float32  " << measure<float>(path) * 1e-9 << " GB/s\n";
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_parallel.hpp>
+
+
+// Large enough to be allocated by mmap, so pages are untouched on allocation.
+constexpr std::size_t array_size = std::size_t(1) << 25;
+
+// sink keeps consumed numbers from being optimized out.
+volatile double sink;
+
+struct measurement_result
+{
+    double fill_time;
+    double consume_time;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os
+        << result.fill_time * 1e9 << " ns/gen\t"
+        << result.consume_time * 1e9 << " ns/read";
+}
+
+// consume sums the subrange of each node in threads bound to the node, which
+// is the access pattern NUMA-aware filling optimizes for.
+double consume(double const* data, cxx::numa_topology const& topology)
+{
+    auto const ranges = cxx::numa_partition(array_size, topology);
+    std::vector<double> sums(topology.nodes.size() * 8);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < topology.nodes.size(); i++) {
+        threads.emplace_back([&, i] {
+            cxx::ziggurat_detail::bind_thread(topology.nodes[i].cpus);
+            double sum = 0;
+            for (std::size_t j = ranges[i].first; j < ranges[i].second; j++) {
+                sum += data[j];
+            }
+            sums[i * 8] = sum;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double sum = 0;
+    for (double s : sums) {
+        sum += s;
+    }
+    return sum;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F fill, cxx::numa_topology const& topology)
+{
+    using clock = std::chrono::steady_clock;
+    using seconds = std::chrono::duration<double>;
+
+    std::unique_ptr<double[]> data{new double[array_size]};
+
+    auto start_time = clock::now();
+    fill(data.get(), data.get() + array_size);
+    auto fill_time = clock::now();
+    sink = consume(data.get(), topology);
+    auto end_time = clock::now();
+
+    measurement_result result;
+    result.fill_time = seconds(fill_time - start_time).count() / double(array_size);
+    result.consume_time = seconds(end_time - fill_time).count() / double(array_size);
+    return result;
+}
+
+// simulate_topology splits the CPUs of the system into node_count nodes.
+cxx::numa_topology simulate_topology(std::size_t node_count)
+{
+    std::vector<int> cpus;
+    for (auto const& node : cxx::detect_numa_topology().nodes) {
+        cpus.insert(cpus.end(), node.cpus.begin(), node.cpus.end());
+    }
+
+    cxx::numa_topology topology;
+    topology.nodes.resize(node_count);
+
+    for (std::size_t i = 0; i < cpus.size(); i++) {
+        topology.nodes[i * node_count / cpus.size()].cpus.push_back(cpus[i]);
+    }
+    for (std::size_t i = 0; i < node_count; i++) {
+        topology.nodes[i].id = int(i);
+    }
+    return topology;
+}
+
+void run(cxx::numa_topology const& topology)
+{
+    std::size_t thread_count = 0;
+    for (auto const& node : topology.nodes) {
+        thread_count += std::max(node.cpus.size(), std::size_t(1));
+    }
+
+    auto plain_fill = [&](double* first, double* last) {
+        cxx::parallel_generate(first, last, 0, thread_count);
+    };
+
+    auto numa_fill = [&](double* first, double* last) {
+        cxx::numa_parallel_generate(first, last, 0, topology);
+    };
+
+    std::cout << "plain\t" << measure(plain_fill, topology) << '\n';
+    std::cout << "numa\t" << measure(numa_fill, topology) << '\n';
+}
+
+int main()
+{
+    auto const topology = cxx::detect_numa_topology();
+
+    std::cout << "detected topology (" << topology.nodes.size() << " nodes)\n";
+    run(topology);
+    std::cout << '\n';
+
+    std::cout << "simulated topology (2 nodes)\n";
+    run(simulate_topology(2));
+}
@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_process.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t step_count = 10;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/update\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(std::size_t update_count, F sum_states)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_states();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / double(update_count);
+    result.mean = double(sum) / double(update_count) * step_count;
+    return result;
+}
+
+template<typename T>
+T sum_states(std::vector<T> const& state)
+{
+    T sum = 0;
+    for (T x : state) {
+        sum += x;
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+void run(char const* name, std::size_t count)
+{
+    Engine engine;
+    cxx::ou_stepper<T> ou{T(1), T(0.5), T(0.01), T(1)};
+    cxx::ziggurat_normal_distribution<T> normal;
+
+    auto const mu = ou.mu();
+    auto const decay = ou.decay();
+    auto const scale = ou.noise_scale();
+    auto const update_count = count * step_count;
+
+    std::vector<T> state(count);
+    std::vector<T> noise(count);
+
+    // Scalar loop calling the normal distribution for each process.
+    std::fill(state.begin(), state.end(), T(0));
+    std::cout << name << " scalar    " << measure(update_count, [&] {
+        for (std::size_t s = 0; s < step_count; s++) {
+            for (std::size_t i = 0; i < count; i++) {
+                state[i] = mu + decay * (state[i] - mu) + scale * normal(engine);
+            }
+        }
+        return sum_states(state);
+    }) << '\n';
+
+    // Two passes: the whole noise array is generated and then applied.
+    std::fill(state.begin(), state.end(), T(0));
+    std::cout << name << " two-pass  " << measure(update_count, [&] {
+        for (std::size_t s = 0; s < step_count; s++) {
+            normal.generate(noise.begin(), noise.end(), engine);
+            for (std::size_t i = 0; i < count; i++) {
+                state[i] = mu + decay * (state[i] - mu) + scale * noise[i];
+            }
+        }
+        return sum_states(state);
+    }) << '\n';
+
+    std::fill(state.begin(), state.end(), T(0));
+    std::cout << name << " fused     " << measure(update_count, [&] {
+        ou.step(state.data(), count, step_count, engine);
+        return sum_states(state);
+    }) << '\n';
+}
+
+int main()
+{
+    for (std::size_t count : {std::size_t(1) << 20, std::size_t(1) << 24}) {
+        std::cout << "double processes=" << count << '\n';
+        run<double, std::mt19937_64>("MT64", count);
+        run<double, jsf64>("JSF ", count);
+        std::cout << '\n';
+
+        std::cout << "float processes=" << count << '\n';
+        run<float, jsf64>("JSF ", count);
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_parallel.hpp>
+
+
+constexpr std::size_t array_size = std::size_t(1) << 25;
+constexpr int repeat_count = 4;
+
+struct measurement_result
+{
+    double time;
+    double bandwidth;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.bandwidth * 1e-9 << " GB/s";
+}
+
+template<typename T>
+__attribute__((noinline))
+measurement_result measure(std::vector<T>& samples, std::size_t thread_count)
+{
+    using clock = std::chrono::steady_clock;
+
+    // Warm up: page in the array.
+    cxx::parallel_generate(samples.begin(), samples.end(), 0, thread_count);
+
+    auto start_time = clock::now();
+
+    for (int i = 0; i < repeat_count; i++) {
+        cxx::parallel_generate(samples.begin(), samples.end(), std::uint64_t(i), thread_count);
+    }
+
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    auto const generation_count = double(samples.size()) * repeat_count;
+
+    measurement_result result;
+    result.time = elapsed_time.count() / generation_count;
+    result.bandwidth = double(sizeof(T)) / result.time;
+    return result;
+}
+
+template<typename T>
+void run_scaling()
+{
+    std::vector<T> samples(array_size);
+
+    std::size_t const max_threads = std::max(1U, std::thread::hardware_concurrency());
+
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    double base_time = 0;
+
+    for (auto threads : thread_counts) {
+        auto const result = measure(samples, threads);
+        if (threads == 1) {
+            base_time = result.time;
+        }
+        std::cout
+            << threads << " threads\t" << result
+            << "\tx" << base_time / result.time << '\n';
+    }
+}
+
+int main()
+{
+    std::cout << "double\n";
+    run_scaling<double>();
+    std::cout << '\n';
+    std::cout << "float\n";
+    run_scaling<float>();
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_buffer.hpp>
+
+
+constexpr std::size_t call_count = 1000000;
+
+using clock_type = std::chrono::steady_clock;
+
+// sink keeps generated numbers from being optimized out.
+volatile double sink;
+
+struct latency_result
+{
+    double p50;
+    double p99;
+    double p999;
+    double max;
+};
+
+std::ostream& operator<<(std::ostream& os, latency_result result)
+{
+    return os
+        << result.p50 << '\t' << result.p99 << '\t' << result.p999 << '\t'
+        << result.max;
+}
+
+// simulate_work spins for a while to model the request handling that happens
+// between draws.
+__attribute__((noinline))
+void simulate_work(clock_type::duration duration)
+{
+    auto const deadline = clock_type::now() + duration;
+    while (clock_type::now() < deadline) {
+    }
+}
+
+// measure records the latency of each call to gen in nanoseconds.
+template<typename F>
+__attribute__((noinline))
+latency_result measure(F gen, clock_type::duration gap)
+{
+    std::vector<double> latencies(call_count);
+    double sum = 0;
+
+    for (std::size_t i = 0; i < call_count; i++) {
+        auto const start_time = clock_type::now();
+        sum += gen();
+        auto const end_time = clock_type::now();
+
+        latencies[i] = std::chrono::duration<double, std::nano>(end_time - start_time).count();
+
+        if (gap.count() > 0) {
+            simulate_work(gap);
+        }
+    }
+
+    sink = sum;
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&](double p) {
+        return latencies[std::size_t(p * double(call_count - 1))];
+    };
+
+    latency_result result;
+    result.p50 = percentile(0.5);
+    result.p99 = percentile(0.99);
+    result.p999 = percentile(0.999);
+    result.max = latencies.back();
+    return result;
+}
+
+void run(clock_type::duration gap)
+{
+    std::mt19937_64 engine;
+    cxx::ziggurat_normal_distribution<double> normal;
+    cxx::prefetch_normal_source<double> prefetch{0};
+
+    std::cout << "clock only\t" << measure([] { return 0.0; }, gap) << '\n';
+    std::cout << "operator()\t" << measure([&] { return normal(engine); }, gap) << '\n';
+    std::cout << "prefetch\t" << measure([&] { return prefetch(); }, gap) << '\n';
+}
+
+int main()
+{
+    std::cout << "back-to-back calls\tp50\tp99\tp99.9\tmax (ns)\n";
+    run(std::chrono::nanoseconds(0));
+    std::cout << '\n';
+
+    std::cout << "calls between 1us work\tp50\tp99\tp99.9\tmax (ns)\n";
+    run(std::chrono::microseconds(1));
+}
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_parallel.hpp>
+
+
+constexpr std::size_t small_request_count = 20000;
+constexpr std::size_t large_request_count = 8;
+constexpr std::size_t large_request_size = std::size_t(1) << 21;
+
+// make_sizes returns a skewed mix of request sizes: many small requests of
+// varying length (e.g. per-path increments) and a few large fills clustered
+// at the end, which defeats a static partition.
+std::vector<std::size_t> make_sizes()
+{
+    std::mt19937_64 random;
+    std::uniform_int_distribution<std::size_t> small_size{16, 2048};
+
+    std::vector<std::size_t> sizes;
+    for (std::size_t i = 0; i < small_request_count; i++) {
+        sizes.push_back(small_size(random));
+    }
+    for (std::size_t i = 0; i < large_request_count; i++) {
+        sizes.push_back(large_request_size);
+    }
+    return sizes;
+}
+
+// static_generate statically assigns consecutive requests to threads so that
+// each thread gets the same number of requests.
+void static_generate(
+    std::vector<cxx::generate_request<double>> const& requests,
+    std::uint64_t seed,
+    std::size_t thread_count
+)
+{
+    auto worker = [&](std::size_t id) {
+        auto const begin = requests.size() * id / thread_count;
+        auto const end = requests.size() * (id + 1) / thread_count;
+
+        for (auto i = begin; i < end; i++) {
+            std::mt19937_64 engine{cxx::ziggurat_detail::stream_seed(seed, i)};
+            cxx::ziggurat_normal_distribution<double> normal;
+            normal.generate(requests[i].first, requests[i].last, engine);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < thread_count; i++) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template<typename F>
+__attribute__((noinline))
+double measure(F generate)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto const start_time = clock::now();
+    generate();
+    auto const end_time = clock::now();
+
+    return std::chrono::duration<double>(end_time - start_time).count();
+}
+
+int main()
+{
+    auto const sizes = make_sizes();
+
+    std::vector<std::vector<double>> arrays;
+    std::vector<cxx::generate_request<double>> requests;
+    std::size_t total_size = 0;
+
+    for (auto size : sizes) {
+        arrays.emplace_back(size);
+        total_size += size;
+    }
+    for (auto& array : arrays) {
+        requests.emplace_back(array.data(), array.data() + array.size());
+    }
+
+    std::size_t const max_threads = std::max(1U, std::thread::hardware_concurrency());
+
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    std::cout << requests.size() << " requests, " << total_size << " numbers\n";
+    std::cout << "threads\tstatic\tstealing\t(ns/gen)\n";
+
+    for (auto threads : thread_counts) {
+        auto const static_time = measure([&] {
+            static_generate(requests, 0, threads);
+        });
+        auto const stealing_time = measure([&] {
+            cxx::parallel_generate(requests, 0, threads);
+        });
+
+        std::cout
+            << threads
+            << '\t' << static_time / double(total_size) * 1e9
+            << '\t' << stealing_time / double(total_size) * 1e9
+            << '\n';
+    }
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_parallel.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr int generation_count = 10000000;
+
+// Naive approach: engines are packed in a vector and indexed by thread.
+template<typename Engine>
+struct shared_vector_source
+{
+    std::vector<Engine> engines;
+    cxx::ziggurat_normal_distribution<double> normal;
+
+    explicit shared_vector_source(std::size_t thread_count)
+    {
+        for (std::size_t i = 0; i < thread_count; i++) {
+            engines.emplace_back(typename Engine::result_type(i));
+        }
+    }
+
+    double operator()(std::size_t thread)
+    {
+        return normal(engines[thread]);
+    }
+};
+
+template<typename Engine>
+struct thread_local_source
+{
+    explicit thread_local_source(std::size_t)
+    {
+    }
+
+    double operator()(std::size_t)
+    {
+        return cxx::thread_normal<double, Engine>();
+    }
+};
+
+template<typename Source>
+__attribute__((noinline))
+double measure(std::size_t thread_count)
+{
+    using clock = std::chrono::steady_clock;
+
+    Source source{thread_count};
+    std::vector<double> sums(thread_count * 8);
+
+    auto worker = [&](std::size_t thread) {
+        double sum = 0;
+        for (int i = 0; i < generation_count; i++) {
+            sum += source(thread);
+        }
+        sums[thread * 8] = sum;
+    };
+
+    auto start_time = clock::now();
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < thread_count; i++) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    // Wall time per generation per thread.
+    return elapsed_time.count() / generation_count;
+}
+
+int main()
+{
+    std::size_t const max_threads = std::max(1U, std::thread::hardware_concurrency());
+
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    std::cout << "threads\tMT64 vector\tMT64 local\tJSF vector\tJSF local\t(ns/gen)\n";
+
+    for (auto threads : thread_counts) {
+        std::cout
+            << threads
+            << '\t' << measure<shared_vector_source<std::mt19937_64>>(threads) * 1e9
+            << '\t' << measure<thread_local_source<std::mt19937_64>>(threads) * 1e9
+            << '\t' << measure<shared_vector_source<jsf64>>(threads) * 1e9
+            << '\t' << measure<thread_local_source<jsf64>>(threads) * 1e9
+            << '\n';
+    }
+}
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <ziggurat_truncated.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t generation_count = 5000000;
+
+struct measurement_result
+{
+    double time;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.time * 1e9 << " ns/gen\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_samples)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_samples();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.time = elapsed_time.count() / generation_count;
+    result.mean = double(sum) / generation_count;
+    return result;
+}
+
+// Naive rejection from untruncated normal numbers, for reference. It is run
+// only where the acceptance rate is not hopeless.
+template<typename T, typename Engine>
+T sum_naive(T a, T b, Engine& engine)
+{
+    cxx::ziggurat_normal_distribution<T> normal;
+    T sum = 0;
+    for (std::size_t i = 0; i < generation_count; i++) {
+        T x;
+        do {
+            x = normal(engine);
+        } while (x < a || x > b);
+        sum += x;
+    }
+    return sum;
+}
+
+template<typename T, typename Engine>
+void run(char const* name, T a, T b)
+{
+    Engine engine;
+    cxx::ziggurat_truncated_normal_distribution<T> dist{0, 1, a, b};
+    std::vector<T> buffer(generation_count);
+
+    if (a < 2) {
+        std::cout << name << " naive     " << measure([&] { return sum_naive(a, b, engine); }) << '\n';
+    }
+    std::cout << name << " truncated " << measure([&] {
+        T sum = 0;
+        for (std::size_t i = 0; i < generation_count; i++) {
+            sum += dist(engine);
+        }
+        return sum;
+    }) << '\n';
+    std::cout << name << " generate  " << measure([&] {
+        dist.generate(buffer.begin(), buffer.end(), engine);
+        T sum = 0;
+        for (T x : buffer) {
+            sum += x;
+        }
+        return sum;
+    }) << '\n';
+}
+
+int main()
+{
+    double const inf = std::numeric_limits<double>::infinity();
+
+    struct interval
+    {
+        double a;
+        double b;
+    };
+    interval const intervals[] = {
+        {-1, 1},
+        {-inf, 0.5},
+        {0.2, 0.4},
+        {0.3, inf},
+        {1, inf},
+        {3, inf},
+        {10, inf},
+        {4, 4.1},
+    };
+
+    for (auto const& iv : intervals) {
+        std::cout << "double [" << iv.a << ", " << iv.b << "]\n";
+        run<double, std::mt19937_64>("MT64", iv.a, iv.b);
+        run<double, jsf64>("JSF ", iv.a, iv.b);
+        std::cout << '\n';
+    }
+}
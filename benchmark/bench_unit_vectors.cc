@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <ziggurat_sphere.hpp>
+
+#include "jsf.hpp"
+
+
+constexpr std::size_t vector_count = 5000000;
+
+struct measurement_result
+{
+    double rate;
+    double mean;
+};
+
+std::ostream& operator<<(std::ostream& os, measurement_result result)
+{
+    return os << result.rate * 1e-6 << " Mvec/s\t" << result.mean;
+}
+
+template<typename F>
+__attribute__((noinline))
+measurement_result measure(F sum_coords)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto start_time = clock::now();
+    auto sum = sum_coords();
+    auto end_time = clock::now();
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+        end_time - start_time
+    );
+
+    measurement_result result;
+    result.rate = vector_count / elapsed_time.count();
+    result.mean = double(sum) / vector_count;
+    return result;
+}
+
+template<typename T>
+T sum_buffer(std::vector<T> const& buffer)
+{
+    T sum = 0;
+    for (T x : buffer) {
+        sum += x;
+    }
+    return sum;
+}
+
+// Scalar normalization of n normal numbers per vector.
+template<typename T, typename Engine>
+T naive_vectors(std::vector<T>& out, std::size_t n, Engine& engine)
+{
+    cxx::ziggurat_normal_distribution<T> normal;
+
+    for (std::size_t k = 0; k < vector_count; k++) {
+        auto const v = out.data() + k * n;
+        T norm2 = 0;
+        for (std::size_t d = 0; d < n; d++) {
+            v[d] = normal(engine);
+            norm2 += v[d] * v[d];
+        }
+        auto const scale = 1 / std::sqrt(norm2);
+        for (std::size_t d = 0; d < n; d++) {
+            v[d] *= scale;
+        }
+    }
+    return sum_buffer(out);
+}
+
+// Marsaglia (1972) rejection method for the 2-sphere.
+template<typename T, typename Engine>
+T marsaglia_vectors(std::vector<T>& out, Engine& engine)
+{
+    for (std::size_t k = 0; k < vector_count; k++) {
+        T u, v, s;
+        do {
+            u = 2 * cxx::ziggurat_detail::generate_uniform<T>(engine) - 1;
+            v = 2 * cxx::ziggurat_detail::generate_uniform<T>(engine) - 1;
+            s = u * u + v * v;
+        } while (s >= 1);
+
+        auto const scale = 2 * std::sqrt(1 - s);
+        out[k * 3 + 0] = u * scale;
+        out[k * 3 + 1] = v * scale;
+        out[k * 3 + 2] = 1 - 2 * s;
+    }
+    return sum_buffer(out);
+}
+
+template<typename T, typename Engine>
+void run(char const* name, std::size_t n)
+{
+    Engine engine;
+    std::vector<T> buffer(vector_count * n);
+    cxx::unit_vector_generator<T> interleaved{n, cxx::vector_layout::interleaved};
+    cxx::unit_vector_generator<T> planar{n, cxx::vector_layout::planar};
+
+    std::cout << name << " naive        " << measure([&] {
+        return naive_vectors(buffer, n, engine);
+    }) << '\n';
+    if (n == 3) {
+        std::cout << name << " marsaglia    " << measure([&] {
+            return marsaglia_vectors(buffer, engine);
+        }) << '\n';
+    }
+    std::cout << name << " interleaved  " << measure([&] {
+        interleaved.generate(buffer.data(), vector_count, engine);
+        return sum_buffer(buffer);
+    }) << '\n';
+    std::cout << name << " planar       " << measure([&] {
+        planar.generate(buffer.data(), vector_count, engine);
+        return sum_buffer(buffer);
+    }) << '\n';
+}
+
+int main()
+{
+    for (std::size_t n : {std::size_t(3), std::size_t(2), std::size_t(10)}) {
+        std::cout << "double n=" << n << '\n';
+        run<double, std::mt19937_64>("MT64", n);
+        run<double, jsf64>("JSF ", n);
+        std::cout << '\n';
+
+        std::cout << "float n=" << n << '\n';
+        run<float, std::mt19937_64>("MT64", n);
+        run<float, jsf64>("JSF ", n);
+        std::cout << '\n';
+    }
+}
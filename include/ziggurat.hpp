@@ -28,11 +28,13 @@
 #ifndef INCLUDED_ZIGGURAT_HPP
 #define INCLUDED_ZIGGURAT_HPP
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <ios>
 #include <istream>
+#include <iterator>
 #include <limits>
 #include <ostream>
 #include <random>
@@ -64,6 +66,19 @@ namespace cxx
             return num / 2 ? 1 + log2(num / 2) : 0;
         }
 
+        // engine_bits is the number of random bits the ziggurat algorithm
+        // draws from a single invocation of URNG.
+        template<typename URNG>
+        inline constexpr std::size_t engine_bits()
+        {
+            return log2(URNG::max() - URNG::min());
+        }
+
+        // bulk_block_size is the number of samples the bulk generation kernel
+        // processes in a single pass. Splitting a range into subranges of
+        // multiples of this size does not change the generated sequence.
+        constexpr std::size_t bulk_block_size = 128;
+
         // generate_bits draws N random bits from given random number generator.
         template<std::size_t N, typename URNG>
         inline std::uint64_t generate_bits(URNG& random)
@@ -89,6 +104,14 @@ namespace cxx
             return norm * T(bits >> (uint_bits - data_bits));
         }
 
+        // generate_uniform returns a uniform random number in [0, 1).
+        template<typename T, typename URNG>
+        inline T generate_uniform(URNG& random)
+        {
+            constexpr std::size_t bit_count = engine_bits<URNG>();
+            return canonicalize<bit_count, T>(generate_bits<bit_count>(random));
+        }
+
         // gaussian returns exp(-x^2/2).
         template<typename T>
         inline T gaussian(T x)
@@ -96,6 +119,11 @@ namespace cxx
             return std::exp(T(-0.5) * x * x);
         }
 
+        // table_version identifies the ziggurat table and the way samples are
+        // derived from random bits. It is bumped whenever a change alters the
+        // generated sequences so that stored numbers can be traced back.
+        constexpr std::uint32_t table_version = 1;
+
         // normal_ziggurat holds a pre-computed ziggurat table.
         template<typename T>
         struct normal_ziggurat
@@ -240,6 +268,67 @@ namespace cxx
             return param.mean() + param.stddev() * sample(random);
         }
 
+        // generate fills the range [first, last) with normal random numbers
+        // with the preconfigured parameters. The fast path is vectorized, so
+        // this is faster than invoking the distribution for each element on
+        // targets with SIMD gather (e.g. AVX2). Note that the engine is
+        // consumed in a different order, so the generated sequence differs
+        // from the one generated by repeated operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            generate(first, last, random, param_);
+        }
+
+        // generate fills the range [first, last) with normal random numbers
+        // with given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            constexpr std::size_t bit_count = ziggurat_detail::engine_bits<URNG>();
+            constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+            std::uint64_t bits[block_size];
+            T samples[block_size];
+            bool accepts[block_size];
+
+            auto remaining = std::size_t(std::distance(first, last));
+
+            while (remaining > 0) {
+                auto const count = std::min(remaining, block_size);
+
+                for (std::size_t i = 0; i < count; i++) {
+                    bits[i] = ziggurat_detail::generate_bits<bit_count>(random);
+                }
+
+                // The fast path is branch-free so that the compiler can
+                // vectorize this loop.
+                for (std::size_t i = 0; i < count; i++) {
+                    auto const uniform = ziggurat_detail::canonicalize<bit_count, T>(bits[i]);
+                    auto const layer = std::size_t(bits[i] & 0x7F);
+                    auto const sign = T((bits[i] & 0x80) ? 1 : -1);
+                    auto const x = uniform * ziggurat::edges[layer];
+
+                    samples[i] = sign * x;
+                    accepts[i] = x < ziggurat::edges[layer + 1];
+                }
+
+                for (std::size_t i = 0; i < count; i++) {
+                    auto const z = ZIGGURAT_LIKELY(accepts[i])
+                        ? samples[i] : finish_sample<bit_count>(random, bits[i]);
+                    *first = param.mean() + param.stddev() * z;
+                    ++first;
+                }
+
+                remaining -= count;
+            }
+        }
+
         // mean returns the mean parameter of this distribution.
         result_type mean() const
         {
@@ -281,7 +370,7 @@ namespace cxx
         template<typename URNG>
         inline T sample(URNG& random) const
         {
-            constexpr std::size_t bit_count = ziggurat_detail::log2(URNG::max() - URNG::min());
+            constexpr std::size_t bit_count = ziggurat_detail::engine_bits<URNG>();
 
             for (;;)
             {
@@ -309,6 +398,32 @@ namespace cxx
             }
         }
 
+        // finish_sample continues a sampling step whose fast-path test failed
+        // in the bulk generation kernel.
+        template<std::size_t N, typename URNG>
+        ZIGGURAT_NOINLINE
+        T finish_sample(URNG& random, std::uint64_t bits) const
+        {
+            auto const uniform = ziggurat_detail::canonicalize<N, T>(bits);
+            auto const layer = std::size_t(bits & 0x7F);
+            auto const sign = T((bits & 0x80) ? 1 : -1);
+
+            auto const lower_edge = ziggurat::edges[layer];
+            auto const upper_edge = ziggurat::edges[layer + 1];
+
+            auto const x = uniform * lower_edge;
+
+            if (layer == 0) {
+                return sign * sample_from_tail(random);
+            }
+
+            if (check_accept(random, lower_edge, upper_edge, x)) {
+                return sign * x;
+            }
+
+            return sample(random);
+        }
+
         template<typename URNG>
         ZIGGURAT_NOINLINE
         T sample_from_tail(URNG& random) const
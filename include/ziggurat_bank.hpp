@@ -0,0 +1,406 @@
+// Memory-mapped files of pre-generated normal random numbers
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_BANK_HPP
+#define INCLUDED_ZIGGURAT_BANK_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ziggurat.hpp"
+#include "ziggurat_parallel.hpp"
+
+
+namespace cxx
+{
+    // noise_bank_header is the header at the beginning of a noise bank file.
+    // The numbers follow at data_offset, which is aligned to a page. Integers
+    // are stored in the native byte order; byte_order_mark tells a reader
+    // whether the order matches its own.
+    struct noise_bank_header
+    {
+        char magic[8];
+        std::uint32_t format_version;
+        std::uint32_t byte_order_mark;
+        std::uint32_t value_size;
+        std::uint32_t table_version;
+        std::uint64_t count;
+        std::uint64_t seed;
+        std::uint64_t data_offset;
+        char engine[64];
+    };
+
+    namespace ziggurat_detail
+    {
+        constexpr char noise_bank_magic[8] = {'Z', 'I', 'G', 'B', 'A', 'N', 'K', '\0'};
+        constexpr std::uint32_t noise_bank_format_version = 1;
+        constexpr std::uint32_t noise_bank_byte_order_mark = 0x01020304;
+        constexpr std::uint64_t noise_bank_data_offset = 4096;
+
+        // engine_name returns a name identifying Engine. Standard engines get
+        // their standard names and other engines the implementation-defined
+        // type name.
+        template<typename Engine>
+        struct engine_name
+        {
+            static char const* get()
+            {
+                return typeid(Engine).name();
+            }
+        };
+
+#define ZIGGURAT_ENGINE_NAME(engine) \
+        template<> \
+        struct engine_name<std::engine> \
+        { \
+            static char const* get() \
+            { \
+                return #engine; \
+            } \
+        };
+
+        ZIGGURAT_ENGINE_NAME(minstd_rand0)
+        ZIGGURAT_ENGINE_NAME(minstd_rand)
+        ZIGGURAT_ENGINE_NAME(mt19937)
+        ZIGGURAT_ENGINE_NAME(mt19937_64)
+        ZIGGURAT_ENGINE_NAME(ranlux24)
+        ZIGGURAT_ENGINE_NAME(ranlux48)
+        ZIGGURAT_ENGINE_NAME(knuth_b)
+
+#undef ZIGGURAT_ENGINE_NAME
+
+        // throw_system_error throws std::system_error describing errno.
+        [[noreturn]] inline void throw_system_error(std::string const& what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        // file_descriptor owns a POSIX file descriptor.
+        class file_descriptor
+        {
+        public:
+            file_descriptor(std::string const& path, int flags, mode_t mode = 0)
+                : fd_{::open(path.c_str(), flags, mode)}
+            {
+                if (fd_ == -1) {
+                    throw_system_error("cannot open " + path);
+                }
+            }
+
+            file_descriptor(file_descriptor const&) = delete;
+            file_descriptor& operator=(file_descriptor const&) = delete;
+
+            ~file_descriptor()
+            {
+                ::close(fd_);
+            }
+
+            int get() const
+            {
+                return fd_;
+            }
+
+        private:
+            int fd_;
+        };
+
+        // memory_map owns a shared mapping of a whole file.
+        class memory_map
+        {
+        public:
+            memory_map() = default;
+
+            memory_map(int fd, std::size_t size, int protection)
+                : size_{size}
+            {
+                data_ = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+                if (data_ == MAP_FAILED) {
+                    data_ = nullptr;
+                    throw_system_error("cannot map noise bank");
+                }
+            }
+
+            memory_map(memory_map&& other) noexcept
+                : data_{other.data_}, size_{other.size_}
+            {
+                other.data_ = nullptr;
+                other.size_ = 0;
+            }
+
+            memory_map& operator=(memory_map&& other) noexcept
+            {
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+                return *this;
+            }
+
+            ~memory_map()
+            {
+                if (data_) {
+                    ::munmap(data_, size_);
+                }
+            }
+
+            unsigned char* data() const
+            {
+                return static_cast<unsigned char*>(data_);
+            }
+
+            std::size_t size() const
+            {
+                return size_;
+            }
+
+        private:
+            void* data_ = nullptr;
+            std::size_t size_ = 0;
+        };
+    }
+
+    // write_noise_bank creates a noise bank file at path holding count
+    // standard normal random numbers of type T. The numbers are written in
+    // place through a shared mapping by parallel_generate with given seed and
+    // Engine, so the content is identical to what parallel_generate produces
+    // in memory. The header is written last, so an interrupted write leaves
+    // a file that readers reject. Throws std::length_error if the file would
+    // be larger than can be mapped and std::system_error on I/O failure.
+    template<typename T, typename Engine = std::mt19937_64>
+    void write_noise_bank(
+        std::string const& path,
+        std::uint64_t count,
+        std::uint64_t seed,
+        std::size_t thread_count = 0
+    )
+    {
+        static_assert(std::is_floating_point<T>::value, "T must be a floating-point type");
+
+        constexpr std::uint64_t data_offset = ziggurat_detail::noise_bank_data_offset;
+
+        // The file size must fit in both off_t for ftruncate and std::size_t
+        // for mmap.
+        auto const max_file_size = std::min(
+            std::uint64_t(std::numeric_limits<off_t>::max()),
+            std::uint64_t(std::numeric_limits<std::size_t>::max())
+        );
+        if (count > (max_file_size - data_offset) / sizeof(T)) {
+            throw std::length_error("noise bank too large: " + path);
+        }
+        auto const file_size = data_offset + count * sizeof(T);
+
+        ziggurat_detail::file_descriptor file{path, O_RDWR | O_CREAT | O_TRUNC, 0644};
+        if (::ftruncate(file.get(), off_t(file_size)) == -1) {
+            ziggurat_detail::throw_system_error("cannot resize " + path);
+        }
+
+        ziggurat_detail::memory_map const map{
+            file.get(), std::size_t(file_size), PROT_READ | PROT_WRITE
+        };
+
+        auto const data = reinterpret_cast<T*>(map.data() + data_offset);
+        parallel_generate<Engine>(data, data + count, seed, thread_count);
+
+        noise_bank_header header = {};
+        std::memcpy(header.magic, ziggurat_detail::noise_bank_magic, sizeof header.magic);
+        header.format_version = ziggurat_detail::noise_bank_format_version;
+        header.byte_order_mark = ziggurat_detail::noise_bank_byte_order_mark;
+        header.value_size = sizeof(T);
+        header.table_version = ziggurat_detail::table_version;
+        header.count = count;
+        header.seed = seed;
+        header.data_offset = data_offset;
+        std::strncpy(
+            header.engine,
+            ziggurat_detail::engine_name<Engine>::get(),
+            sizeof header.engine - 1
+        );
+
+        if (::msync(map.data(), map.size(), MS_SYNC) == -1) {
+            ziggurat_detail::throw_system_error("cannot write " + path);
+        }
+        std::memcpy(map.data(), &header, sizeof header);
+        if (::msync(map.data(), sizeof header, MS_SYNC) == -1) {
+            ziggurat_detail::throw_system_error("cannot write " + path);
+        }
+    }
+
+    // noise_bank is a read-only view of a noise bank file holding numbers of
+    // type T. The file is mapped into memory, so processes reading the same
+    // bank share the page cache and nothing is copied.
+    template<typename T>
+    class noise_bank
+    {
+    public:
+        // span is a contiguous range of numbers in a bank. It is valid while
+        // the bank is alive.
+        class span
+        {
+        public:
+            span() = default;
+
+            span(T const* data, std::size_t size)
+                : data_{data}, size_{size}
+            {
+            }
+
+            T const* data() const
+            {
+                return data_;
+            }
+
+            std::size_t size() const
+            {
+                return size_;
+            }
+
+            T const* begin() const
+            {
+                return data_;
+            }
+
+            T const* end() const
+            {
+                return data_ + size_;
+            }
+
+            T const& operator[](std::size_t i) const
+            {
+                return data_[i];
+            }
+
+        private:
+            T const* data_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
+        // This constructor maps the noise bank file at path. Throws
+        // std::system_error on I/O failure and std::runtime_error if the file
+        // is not a valid bank of numbers of type T.
+        explicit noise_bank(std::string const& path)
+        {
+            ziggurat_detail::file_descriptor const file{path, O_RDONLY};
+
+            struct stat status;
+            if (::fstat(file.get(), &status) == -1) {
+                ziggurat_detail::throw_system_error("cannot stat " + path);
+            }
+
+            auto const file_size = std::uint64_t(status.st_size);
+            if (file_size < sizeof(noise_bank_header)) {
+                throw std::runtime_error("not a noise bank: " + path);
+            }
+
+            map_ = ziggurat_detail::memory_map{file.get(), std::size_t(file_size), PROT_READ};
+            std::memcpy(&header_, map_.data(), sizeof header_);
+
+            if (std::memcmp(header_.magic, ziggurat_detail::noise_bank_magic, sizeof header_.magic) != 0) {
+                throw std::runtime_error("not a noise bank: " + path);
+            }
+            if (header_.format_version != ziggurat_detail::noise_bank_format_version ||
+                header_.byte_order_mark != ziggurat_detail::noise_bank_byte_order_mark) {
+                throw std::runtime_error("unsupported noise bank format: " + path);
+            }
+            if (header_.value_size != sizeof(T)) {
+                throw std::runtime_error("noise bank value type mismatch: " + path);
+            }
+            if (header_.data_offset % alignof(T) != 0 ||
+                header_.data_offset > file_size ||
+                header_.count > (file_size - header_.data_offset) / sizeof(T)) {
+                throw std::runtime_error("truncated noise bank: " + path);
+            }
+            header_.engine[sizeof header_.engine - 1] = '\0';
+        }
+
+        // size returns the number of numbers in the bank.
+        std::size_t size() const
+        {
+            return std::size_t(header_.count);
+        }
+
+        // seed returns the seed the numbers were generated with.
+        std::uint64_t seed() const
+        {
+            return header_.seed;
+        }
+
+        // engine returns the name of the engine the numbers were generated
+        // with.
+        std::string engine() const
+        {
+            return header_.engine;
+        }
+
+        // table_version returns the ziggurat table version of the generator.
+        std::uint32_t table_version() const
+        {
+            return header_.table_version;
+        }
+
+        // data returns a pointer to the first number.
+        T const* data() const
+        {
+            return reinterpret_cast<T const*>(map_.data() + header_.data_offset);
+        }
+
+        // all returns a span of all the numbers.
+        span all() const
+        {
+            return span{data(), size()};
+        }
+
+        // subspan returns a span of count numbers starting at offset. Throws
+        // std::out_of_range if the span exceeds the bank.
+        span subspan(std::size_t offset, std::size_t count) const
+        {
+            if (offset > size() || count > size() - offset) {
+                throw std::out_of_range("noise bank span out of range");
+            }
+            return span{data() + offset, count};
+        }
+
+    private:
+        ziggurat_detail::memory_map map_;
+        noise_bank_header header_ = {};
+    };
+}
+
+#endif
@@ -0,0 +1,790 @@
+// Buffered normal random number sources
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_BUFFER_HPP
+#define INCLUDED_ZIGGURAT_BUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ziggurat.hpp"
+#include "ziggurat_parallel.hpp"
+
+
+#if defined(__GNUC__)
+# define ZIGGURAT_LIKELY(x) __builtin_expect((x), 1)
+# define ZIGGURAT_NOINLINE __attribute__((noinline))
+#else
+# define ZIGGURAT_LIKELY(x) (x)
+# define ZIGGURAT_NOINLINE
+#endif
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // spsc_ring is a lock-free ring buffer for a single producer thread
+        // and a single consumer thread. The producer writes directly into the
+        // storage of the ring so that it can use the bulk generation kernel.
+        template<typename T>
+        class spsc_ring
+        {
+        public:
+            explicit spsc_ring(std::size_t capacity)
+                : capacity_{round_up_pow2(capacity)}
+                , mask_{capacity_ - 1}
+                , storage_{new T[capacity_]}
+            {
+            }
+
+            // writable returns the pointer to and the length of the longest
+            // contiguous free space. Producer only.
+            std::pair<T*, std::size_t> writable()
+            {
+                auto const head = head_.value.load(std::memory_order_relaxed);
+                auto const tail = tail_.value.load(std::memory_order_acquire);
+
+                auto const offset = head & mask_;
+                auto const free = capacity_ - (head - tail);
+                return {storage_.get() + offset, std::min(free, capacity_ - offset)};
+            }
+
+            // commit publishes count elements written to the space returned by
+            // writable. Producer only.
+            void commit(std::size_t count)
+            {
+                auto const head = head_.value.load(std::memory_order_relaxed);
+                head_.value.store(head + count, std::memory_order_release);
+            }
+
+            // try_pop moves the oldest element to value and returns true, or
+            // returns false if the ring is empty. Consumer only.
+            bool try_pop(T& value)
+            {
+                auto const tail = tail_.value.load(std::memory_order_relaxed);
+
+                if (tail == cached_head_) {
+                    cached_head_ = head_.value.load(std::memory_order_acquire);
+                    if (tail == cached_head_) {
+                        return false;
+                    }
+                }
+
+                value = storage_[tail & mask_];
+                tail_.value.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            std::size_t capacity_;
+            std::size_t mask_;
+            std::unique_ptr<T[]> storage_;
+
+            // Producer and consumer indices live in separate cache lines.
+            // They are value-initialized to zero.
+            cache_padded<std::atomic<std::size_t>> head_{};
+            cache_padded<std::atomic<std::size_t>> tail_{};
+            std::size_t cached_head_ = 0;
+        };
+
+        // mpmc_queue is a bounded lock-free queue for multiple producers and
+        // multiple consumers (Vyukov's algorithm).
+        template<typename T>
+        class mpmc_queue
+        {
+        public:
+            explicit mpmc_queue(std::size_t capacity)
+                : capacity_{round_up_pow2(std::max(capacity, std::size_t(2)))}
+                , mask_{capacity_ - 1}
+                , cells_{new cell[capacity_]}
+            {
+                for (std::size_t i = 0; i < capacity_; i++) {
+                    cells_[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            // try_push appends value to the queue and returns true, or returns
+            // false if the queue is full.
+            bool try_push(T const& value)
+            {
+                auto pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+
+                for (;;) {
+                    auto& slot = cells_[pos & mask_];
+                    auto const seq = slot.sequence.load(std::memory_order_acquire);
+                    auto const diff = std::ptrdiff_t(seq - pos);
+
+                    if (diff == 0) {
+                        if (enqueue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            slot.value = value;
+                            slot.sequence.store(pos + 1, std::memory_order_release);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // try_pop moves the oldest element to value and returns true, or
+            // returns false if the queue is empty.
+            bool try_pop(T& value)
+            {
+                auto pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+
+                for (;;) {
+                    auto& slot = cells_[pos & mask_];
+                    auto const seq = slot.sequence.load(std::memory_order_acquire);
+                    auto const diff = std::ptrdiff_t(seq - (pos + 1));
+
+                    if (diff == 0) {
+                        if (dequeue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            value = slot.value;
+                            slot.sequence.store(pos + capacity_, std::memory_order_release);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+        private:
+            struct cell
+            {
+                std::atomic<std::size_t> sequence;
+                T value;
+            };
+
+            std::size_t capacity_;
+            std::size_t mask_;
+            std::unique_ptr<cell[]> cells_;
+
+            // Value-initialized to zero.
+            cache_padded<std::atomic<std::size_t>> enqueue_pos_{};
+            cache_padded<std::atomic<std::size_t>> dequeue_pos_{};
+        };
+    }
+
+    // buffered_normal_source wraps an engine and a normal distribution and
+    // serves normal random numbers from a small buffer that is refilled by
+    // the bulk ziggurat kernel when exhausted. The default buffer of 256
+    // numbers fits in L1 cache.
+    template<
+        typename T,
+        typename Engine = std::mt19937_64,
+        std::size_t BufferSize = 256
+    >
+    class buffered_normal_source
+    {
+        static_assert(
+            BufferSize > 0 && BufferSize % ziggurat_detail::bulk_block_size == 0,
+            "buffer size must be a multiple of the bulk block size"
+        );
+
+    public:
+        using result_type = T;
+        using engine_type = Engine;
+        using param_type = typename ziggurat_normal_distribution<T>::param_type;
+
+        // buffer_size is the number of numbers generated at once.
+        static constexpr std::size_t buffer_size = BufferSize;
+
+        // Default constructor uses a default-constructed engine and standard
+        // normal distribution.
+        buffered_normal_source() = default;
+
+        // This constructor uses given engine and parameters.
+        explicit buffered_normal_source(
+            Engine const& engine,
+            param_type const& param = param_type{}
+        )
+            : engine_{engine}, param_{param}
+        {
+        }
+
+        // Invoking a source returns a normal random number with the
+        // preconfigured parameters.
+        inline T operator()()
+        {
+            return operator()(param_);
+        }
+
+        // Invoking a source with a parameter object returns a normal random
+        // number with given parameters.
+        inline T operator()(param_type const& param)
+        {
+            if (ZIGGURAT_LIKELY(position_ < BufferSize)) {
+                return param.mean() + param.stddev() * buffer_[position_++];
+            }
+            refill();
+            return param.mean() + param.stddev() * buffer_[position_++];
+        }
+
+        // reset discards buffered numbers. Subsequent numbers are generated
+        // from the current state of the engine.
+        void reset()
+        {
+            position_ = BufferSize;
+        }
+
+        // engine returns the wrapped engine.
+        Engine& engine()
+        {
+            return engine_;
+        }
+
+        Engine const& engine() const
+        {
+            return engine_;
+        }
+
+        // mean returns the mean parameter of this source.
+        result_type mean() const
+        {
+            return param_.mean();
+        }
+
+        // stddev returns the stddev parameter of this source.
+        result_type stddev() const
+        {
+            return param_.stddev();
+        }
+
+        // param returns the parameters of this source.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this source. Buffered numbers are not
+        // discarded because the buffer holds standard normal numbers.
+        void param(param_type const& param)
+        {
+            param_ = param;
+        }
+
+        // available returns the number of buffered numbers not yet served.
+        std::size_t available() const
+        {
+            return BufferSize - position_;
+        }
+
+        // Equality comparison s1 == s2 returns true if and only if s1 and s2
+        // will serve the same sequence.
+        friend bool operator==(
+            buffered_normal_source const& s1,
+            buffered_normal_source const& s2
+        )
+        {
+            return s1.engine_ == s2.engine_
+                && s1.param_ == s2.param_
+                && s1.available() == s2.available()
+                && std::equal(
+                    s1.buffer_ + s1.position_,
+                    s1.buffer_ + BufferSize,
+                    s2.buffer_ + s2.position_
+                );
+        }
+
+        friend bool operator!=(
+            buffered_normal_source const& s1,
+            buffered_normal_source const& s2
+        )
+        {
+            return !(s1 == s2);
+        }
+
+        // Stream output writes the engine state, the parameters and the unread
+        // buffered numbers to a stream. Numbers are written with enough
+        // precision to be restored exactly.
+        template<typename Char, typename Tr>
+        friend std::basic_ostream<Char, Tr>& operator<<(
+            std::basic_ostream<Char, Tr>& os,
+            buffered_normal_source const& source
+        )
+        {
+            using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+            if (sentry_type sentry{os}) {
+                auto const flags = os.flags();
+                auto const precision = os.precision();
+                Char const space = os.widen(' ');
+
+                os.flags(std::ios_base::dec | std::ios_base::left);
+                os.precision(std::numeric_limits<T>::max_digits10);
+
+                os << source.engine_ << space << source.param_ << space << source.available();
+                for (auto i = source.position_; i < BufferSize; i++) {
+                    os << space << source.buffer_[i];
+                }
+
+                os.flags(flags);
+                os.precision(precision);
+            }
+
+            return os;
+        }
+
+        // Stream input reads the state written by the stream output operator.
+        // The source is unchanged if reading fails.
+        template<typename Char, typename Tr>
+        friend std::basic_istream<Char, Tr>& operator>>(
+            std::basic_istream<Char, Tr>& is,
+            buffered_normal_source& source
+        )
+        {
+            using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+            if (sentry_type sentry{is}) {
+                auto const flags = is.flags();
+                is.flags(std::ios_base::dec | std::ios_base::skipws);
+
+                Engine engine;
+                param_type param;
+                std::size_t count = 0;
+
+                if (is >> engine >> param >> count) {
+                    if (count > BufferSize) {
+                        is.setstate(std::ios_base::failbit);
+                    }
+                }
+
+                T unread[BufferSize];
+                for (std::size_t i = 0; is && i < count; i++) {
+                    is >> unread[i];
+                }
+
+                if (is) {
+                    source.engine_ = engine;
+                    source.param_ = param;
+                    source.position_ = BufferSize - count;
+                    std::copy(unread, unread + count, source.buffer_ + source.position_);
+                }
+
+                is.flags(flags);
+            }
+
+            return is;
+        }
+
+    private:
+        ZIGGURAT_NOINLINE
+        void refill()
+        {
+            normal_.generate(buffer_, buffer_ + BufferSize, engine_);
+            position_ = 0;
+        }
+
+    private:
+        Engine engine_;
+        param_type param_;
+        ziggurat_normal_distribution<T> normal_;
+        std::size_t position_ = BufferSize;
+        T buffer_[BufferSize] = {};
+    };
+
+    template<typename T, typename Engine, std::size_t BufferSize>
+    constexpr std::size_t buffered_normal_source<T, Engine, BufferSize>::buffer_size;
+
+    // prefetch_normal_source serves normal random numbers from a ring buffer
+    // that a background thread keeps filled using the bulk ziggurat kernel.
+    // So a call usually costs only a buffer read, and the slow paths of the
+    // algorithm never run in the calling thread. Only one thread may draw
+    // numbers from a source at a time.
+    template<typename T, typename Engine = std::mt19937_64>
+    class prefetch_normal_source
+    {
+    public:
+        using result_type = T;
+        using param_type = typename ziggurat_normal_distribution<T>::param_type;
+
+        // The constructor starts the producer thread that fills the buffer
+        // using an Engine seeded with given seed. capacity is rounded up to a
+        // power of two not less than the bulk block size.
+        explicit prefetch_normal_source(
+            std::uint64_t seed,
+            param_type const& param = param_type{},
+            std::size_t capacity = 65536
+        )
+            : param_{param}
+            , ring_{std::max(capacity, ziggurat_detail::bulk_block_size)}
+            , engine_{typename Engine::result_type(seed)}
+        {
+            producer_ = std::thread{[this] { produce(); }};
+        }
+
+        // The destructor stops and joins the producer thread.
+        ~prefetch_normal_source()
+        {
+            stop_.store(true, std::memory_order_relaxed);
+            producer_.join();
+        }
+
+        prefetch_normal_source(prefetch_normal_source const&) = delete;
+        prefetch_normal_source& operator=(prefetch_normal_source const&) = delete;
+
+        // Invoking a source returns a normal random number with the
+        // preconfigured parameters. It waits for the producer if the buffer
+        // is empty.
+        inline T operator()()
+        {
+            return operator()(param_);
+        }
+
+        // Invoking a source with a parameter object returns a normal random
+        // number with given parameters.
+        inline T operator()(param_type const& param)
+        {
+            T z;
+            if (ZIGGURAT_LIKELY(ring_.try_pop(z))) {
+                return param.mean() + param.stddev() * z;
+            }
+            return param.mean() + param.stddev() * wait_pop();
+        }
+
+        // mean returns the mean parameter of this source.
+        result_type mean() const
+        {
+            return param_.mean();
+        }
+
+        // stddev returns the stddev parameter of this source.
+        result_type stddev() const
+        {
+            return param_.stddev();
+        }
+
+        // param returns the parameters of this source.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this source. Buffered numbers are not
+        // discarded because the buffer holds standard normal numbers.
+        void param(param_type const& param)
+        {
+            param_ = param;
+        }
+
+    private:
+        // max_chunk_size is the maximum number of elements produced at once.
+        static constexpr std::size_t max_chunk_size = 4096;
+
+        ZIGGURAT_NOINLINE
+        T wait_pop()
+        {
+            ziggurat_detail::backoff wait;
+            T z;
+            while (!ring_.try_pop(z)) {
+                wait();
+            }
+            return z;
+        }
+
+        void produce()
+        {
+            ziggurat_detail::backoff wait;
+
+            // The output of the bulk kernel depends on how the output is
+            // partitioned. Multiples of the block size of the kernel keep
+            // the sequence independent of the timing and the capacity.
+            constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+            while (!stop_.load(std::memory_order_relaxed)) {
+                auto const space = ring_.writable();
+
+                if (space.second < block_size) {
+                    wait();
+                    continue;
+                }
+                wait.reset();
+
+                auto const count = std::min(
+                    space.second / block_size * block_size,
+                    std::size_t(max_chunk_size)
+                );
+                normal_.generate(space.first, space.first + count, engine_);
+                ring_.commit(count);
+            }
+        }
+
+    private:
+        param_type param_;
+        ziggurat_detail::spsc_ring<T> ring_;
+        Engine engine_;
+        ziggurat_normal_distribution<T> normal_;
+        std::atomic<bool> stop_{false};
+        std::thread producer_;
+    };
+
+    // normal_block_queue supplies fixed-size blocks of pre-generated standard
+    // normal random numbers to any number of consumer threads. Background
+    // producer threads fill free blocks using the bulk ziggurat kernel and
+    // pass them through lock-free queues, so the cost of synchronization is
+    // amortized over a block. The n-th block produced is filled with an
+    // Engine seeded by a seed derived from the given seed and n, so the
+    // content of a block is reproducible from its sequence number.
+    template<typename T, typename Engine = std::mt19937_64>
+    class normal_block_queue
+    {
+    public:
+        using result_type = T;
+
+        // block is a handle to a block popped from the queue. It returns the
+        // block to the queue for reuse when destroyed.
+        class block
+        {
+        public:
+            block() = default;
+
+            block(block&& other) noexcept
+                : queue_{other.queue_}, index_{other.index_}
+            {
+                other.queue_ = nullptr;
+            }
+
+            block& operator=(block&& other) noexcept
+            {
+                if (this != &other) {
+                    release();
+                    queue_ = other.queue_;
+                    index_ = other.index_;
+                    other.queue_ = nullptr;
+                }
+                return *this;
+            }
+
+            ~block()
+            {
+                release();
+            }
+
+            // data returns the pointer to the numbers in this block, or
+            // nullptr if the handle holds no block.
+            T const* data() const
+            {
+                return queue_ ? queue_->block_data(index_) : nullptr;
+            }
+
+            // size returns the number of numbers in this block.
+            std::size_t size() const
+            {
+                return queue_ ? queue_->block_size_ : 0;
+            }
+
+            T const* begin() const
+            {
+                return data();
+            }
+
+            T const* end() const
+            {
+                return queue_ ? data() + size() : nullptr;
+            }
+
+            T const& operator[](std::size_t i) const
+            {
+                return data()[i];
+            }
+
+            // sequence returns the sequence number of this block. The handle
+            // must hold a block.
+            std::uint64_t sequence() const
+            {
+                return queue_->sequences_[index_];
+            }
+
+        private:
+            friend class normal_block_queue;
+
+            block(normal_block_queue* queue, std::size_t index)
+                : queue_{queue}, index_{index}
+            {
+            }
+
+            void release()
+            {
+                if (queue_) {
+                    queue_->recycle(index_);
+                    queue_ = nullptr;
+                }
+            }
+
+            normal_block_queue* queue_ = nullptr;
+            std::size_t index_ = 0;
+        };
+
+        // The constructor starts producer_count threads that fill block_count
+        // blocks, each holding block_size numbers. block_size is rounded up to
+        // a multiple of the bulk block size.
+        explicit normal_block_queue(
+            std::uint64_t seed,
+            std::size_t producer_count = 1,
+            std::size_t block_size = 4096,
+            std::size_t block_count = 64
+        )
+            : seed_{seed}
+            , block_size_{round_block_size(block_size)}
+            , block_count_{std::max(block_count, std::size_t(1))}
+            , storage_{new T[block_size_ * block_count_]}
+            , sequences_{new std::uint64_t[block_count_]}
+            , free_blocks_{block_count_}
+            , ready_blocks_{block_count_}
+        {
+            for (std::size_t i = 0; i < block_count_; i++) {
+                free_blocks_.try_push(i);
+            }
+
+            for (std::size_t i = 0; i < std::max(producer_count, std::size_t(1)); i++) {
+                producers_.emplace_back([this] { produce(); });
+            }
+        }
+
+        // The destructor stops and joins the producer threads. All blocks
+        // must have been released before.
+        ~normal_block_queue()
+        {
+            stop_.store(true, std::memory_order_relaxed);
+            for (auto& producer : producers_) {
+                producer.join();
+            }
+        }
+
+        normal_block_queue(normal_block_queue const&) = delete;
+        normal_block_queue& operator=(normal_block_queue const&) = delete;
+
+        // pop returns a block of normal random numbers. It waits for the
+        // producers if no block is ready.
+        block pop()
+        {
+            std::size_t index;
+            if (!ready_blocks_.try_pop(index)) {
+                ziggurat_detail::backoff wait;
+                while (!ready_blocks_.try_pop(index)) {
+                    wait();
+                }
+            }
+            return block{this, index};
+        }
+
+        // try_pop sets out to a ready block and returns true, or returns false
+        // if no block is ready.
+        bool try_pop(block& out)
+        {
+            std::size_t index;
+            if (!ready_blocks_.try_pop(index)) {
+                return false;
+            }
+            out = block{this, index};
+            return true;
+        }
+
+        // block_size returns the number of numbers in a block.
+        std::size_t block_size() const
+        {
+            return block_size_;
+        }
+
+    private:
+        static std::size_t round_block_size(std::size_t size)
+        {
+            constexpr std::size_t unit = ziggurat_detail::bulk_block_size;
+            return std::max((size + unit - 1) / unit, std::size_t(1)) * unit;
+        }
+
+        T* block_data(std::size_t index) const
+        {
+            return storage_.get() + index * block_size_;
+        }
+
+        void recycle(std::size_t index)
+        {
+            free_blocks_.try_push(index);
+        }
+
+        void produce()
+        {
+            using seed_type = typename Engine::result_type;
+
+            ziggurat_detail::backoff wait;
+            ziggurat_normal_distribution<T> normal;
+
+            while (!stop_.load(std::memory_order_relaxed)) {
+                std::size_t index;
+                if (!free_blocks_.try_pop(index)) {
+                    wait();
+                    continue;
+                }
+                wait.reset();
+
+                auto const sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+                Engine engine{seed_type(ziggurat_detail::stream_seed(seed_, sequence))};
+
+                auto const data = block_data(index);
+                normal.generate(data, data + block_size_, engine);
+                sequences_[index] = sequence;
+
+                ready_blocks_.try_push(index);
+            }
+        }
+
+    private:
+        std::uint64_t seed_;
+        std::size_t block_size_;
+        std::size_t block_count_;
+        std::unique_ptr<T[]> storage_;
+        std::unique_ptr<std::uint64_t[]> sequences_;
+        ziggurat_detail::mpmc_queue<std::size_t> free_blocks_;
+        ziggurat_detail::mpmc_queue<std::size_t> ready_blocks_;
+        std::atomic<std::uint64_t> next_sequence_{0};
+        std::atomic<bool> stop_{false};
+        std::vector<std::thread> producers_;
+    };
+}
+
+#undef ZIGGURAT_LIKELY
+#undef ZIGGURAT_NOINLINE
+
+#endif
@@ -0,0 +1,400 @@
+// Circularly-symmetric complex normal distribution
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_COMPLEX_HPP
+#define INCLUDED_ZIGGURAT_COMPLEX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <ostream>
+
+#include "ziggurat.hpp"
+
+
+namespace cxx
+{
+    // ziggurat_complex_normal_distribution generates circularly-symmetric
+    // complex normal random numbers: the real and imaginary parts are
+    // independent normal numbers with variance sigma^2 / 2 each, so that
+    // E|z - mean|^2 = sigma^2.
+    template<typename T>
+    class ziggurat_complex_normal_distribution
+    {
+    public:
+        // result_type is an alias of std::complex<T>.
+        using result_type = std::complex<T>;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_complex_normal_distribution;
+
+            // Default constructor initializes mean to 0 and variance to 1.
+            param_type() = default;
+
+            // This constructor initializes the mean and the total variance
+            // sigma^2 to given values.
+            explicit param_type(result_type mean, T variance = 1)
+                : mean_{mean}, variance_{variance}
+            {
+            }
+
+            // mean returns the mean parameter.
+            inline result_type mean() const
+            {
+                return mean_;
+            }
+
+            // variance returns the total variance of the real and imaginary
+            // parts.
+            inline T variance() const
+            {
+                return variance_;
+            }
+
+            // part_stddev returns the standard deviation of the real and
+            // imaginary parts.
+            inline T part_stddev() const
+            {
+                return std::sqrt(variance_ / 2);
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.mean_ == p2.mean_ && p1.variance_ == p2.variance_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes mean and variance to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    Char const space = os.widen(' ');
+                    os << param.mean_ << space << param.variance_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads mean and variance from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.mean_ >> tmp.variance_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            result_type mean_ = 0;
+            T variance_ = 1;
+        };
+
+        // Default constructor creates a standard complex normal distribution.
+        ziggurat_complex_normal_distribution() = default;
+
+        // This constructor creates a complex normal distribution with given
+        // mean and variance.
+        explicit ziggurat_complex_normal_distribution(result_type mean, T variance = 1)
+            : param_{mean, variance}
+        {
+        }
+
+        // This constructor creates a complex normal distribution having given
+        // parameters.
+        explicit ziggurat_complex_normal_distribution(param_type const& param)
+            : param_{param}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated complex normal random number with the preconfigured
+        // parameters.
+        template<typename URNG>
+        inline result_type operator()(URNG& random)
+        {
+            return (*this)(random, param_);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated complex normal random number with
+        // given parameters.
+        template<typename URNG>
+        inline result_type operator()(URNG& random, param_type const& param)
+        {
+            auto const stddev = param.part_stddev();
+            auto const re = normal_(random);
+            auto const im = normal_(random);
+            return param.mean() + result_type{stddev * re, stddev * im};
+        }
+
+        // generate fills the range [first, last) with complex normal random
+        // numbers with the preconfigured parameters. The generated sequence
+        // differs from the one generated by repeated operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            generate(first, last, random, param_);
+        }
+
+        // generate fills the range [first, last) with complex normal random
+        // numbers with given parameters. Numbers are generated through a
+        // buffer of interleaved real and imaginary parts.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+            result_type buffer[block_size];
+
+            auto remaining = std::size_t(std::distance(first, last));
+
+            while (remaining > 0) {
+                auto const count = std::min(remaining, block_size);
+                generate(buffer, buffer + count, random, param);
+                first = std::copy(buffer, buffer + count, first);
+                remaining -= count;
+            }
+        }
+
+        // generate fills an array of complex numbers. The bulk ziggurat kernel
+        // writes the interleaved real and imaginary parts directly to the
+        // array, which is layout-compatible with an array of T.
+        template<typename URNG>
+        void generate(result_type* first, result_type* last, URNG& random)
+        {
+            generate(first, last, random, param_);
+        }
+
+        // generate fills an array of complex numbers with given parameters.
+        template<typename URNG>
+        void generate(
+            result_type* first,
+            result_type* last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            auto const parts = reinterpret_cast<T*>(first);
+            auto const part_count = 2 * std::size_t(last - first);
+
+            normal_.generate(
+                parts,
+                parts + part_count,
+                random,
+                typename ziggurat_normal_distribution<T>::param_type{0, param.part_stddev()}
+            );
+
+            if (param.mean() != result_type{}) {
+                for (auto z = first; z != last; ++z) {
+                    *z += param.mean();
+                }
+            }
+        }
+
+        // mean returns the mean parameter of this distribution.
+        result_type mean() const
+        {
+            return param_.mean();
+        }
+
+        // variance returns the variance parameter of this distribution.
+        T variance() const
+        {
+            return param_.variance();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+        }
+
+    private:
+        param_type param_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename T>
+    bool operator==(
+        ziggurat_complex_normal_distribution<T> const& d1,
+        ziggurat_complex_normal_distribution<T> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    // Inequality comparison d1 != d2 compares the inequality of distribution
+    // parameters.
+    template<typename T>
+    bool operator!=(
+        ziggurat_complex_normal_distribution<T> const& d1,
+        ziggurat_complex_normal_distribution<T> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output operator writes the parameters of a distribution to a
+    // stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_complex_normal_distribution<T> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input operator reads the parameters of a distribution from a
+    // stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_complex_normal_distribution<T>& dist
+    )
+    {
+        typename ziggurat_complex_normal_distribution<T>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+
+    // add_noise adds circularly-symmetric complex normal noise with given
+    // variance to each of the size numbers at data in place. The noise is
+    // generated into a local block and added in a loop with a fixed trip
+    // count, which is vectorized.
+    template<typename T, typename URNG>
+    void add_noise(std::complex<T>* data, std::size_t size, T variance, URNG& random)
+    {
+        constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+        ziggurat_normal_distribution<T> normal;
+        typename ziggurat_normal_distribution<T>::param_type const param{0, std::sqrt(variance / 2)};
+
+        auto const parts = reinterpret_cast<T*>(data);
+        auto const part_count = 2 * size;
+
+        T noise[block_size];
+        std::size_t i = 0;
+
+        for (; i + block_size <= part_count; i += block_size) {
+            normal.generate(noise, noise + block_size, random, param);
+            for (std::size_t k = 0; k < block_size; k++) {
+                parts[i + k] += noise[k];
+            }
+        }
+
+        if (i < part_count) {
+            auto const count = part_count - i;
+            normal.generate(noise, noise + count, random, param);
+            for (std::size_t k = 0; k < count; k++) {
+                parts[i + k] += noise[k];
+            }
+        }
+    }
+
+    // add_noise_at_snr adds complex normal noise to the size numbers at data
+    // in place so that the ratio of given signal power to the noise power is
+    // snr_db decibels. Returns the variance of the added noise.
+    template<typename T, typename URNG>
+    T add_noise_at_snr(
+        std::complex<T>* data,
+        std::size_t size,
+        T snr_db,
+        T signal_power,
+        URNG& random
+    )
+    {
+        auto const variance = signal_power * std::pow(T(10), -snr_db / 10);
+        add_noise(data, size, variance, random);
+        return variance;
+    }
+
+    // add_noise_at_snr adds complex normal noise to the size numbers at data
+    // in place so that the ratio of the signal power to the noise power is
+    // snr_db decibels. The signal power is measured as the mean of |z|^2 of
+    // the data. Returns the variance of the added noise.
+    template<typename T, typename URNG>
+    T add_noise_at_snr(std::complex<T>* data, std::size_t size, T snr_db, URNG& random)
+    {
+        auto const parts = reinterpret_cast<T*>(data);
+
+        double power = 0;
+        for (std::size_t i = 0; i < 2 * size; i++) {
+            power += double(parts[i]) * double(parts[i]);
+        }
+        power /= double(std::max<std::size_t>(size, 1));
+
+        return add_noise_at_snr(data, size, snr_db, T(power), random);
+    }
+}
+
+#endif
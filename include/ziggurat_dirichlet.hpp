@@ -0,0 +1,291 @@
+// Dirichlet random vectors built on the ziggurat gamma distribution
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_DIRICHLET_HPP
+#define INCLUDED_ZIGGURAT_DIRICHLET_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "ziggurat.hpp"
+#include "ziggurat_gamma.hpp"
+
+#if defined(__GNUC__)
+# define ZIGGURAT_LIKELY(x) __builtin_expect((x), 1)
+#else
+# define ZIGGURAT_LIKELY(x) (x)
+#endif
+
+
+namespace cxx
+{
+    // dirichlet_generator generates Dirichlet random vectors with given
+    // concentration parameters alpha_1, ..., alpha_K as vectors of gamma
+    // random numbers G(alpha_k) divided by their sum. The gamma numbers are
+    // generated by the method of Marsaglia and Tsang in blocks: a block of
+    // normal numbers is drawn by the bulk ziggurat kernel and the squeeze
+    // test runs across the block with per-component constants, so distinct
+    // shapes do not fall back to scalar sampling. Small dimensions pack
+    // several vectors into a block. Generating vectors allocates nothing.
+    //
+    // Gamma numbers with shapes well below one often underflow to zero, and
+    // all components of a vector may do so for sparse priors. The boost
+    // factors of such components are therefore kept as logarithms, and a
+    // vector is rescaled by its largest boost before it is normalized, so
+    // that it always sums to one.
+    template<typename T>
+    class dirichlet_generator
+    {
+    public:
+        // This constructor creates a Dirichlet distribution with given
+        // concentration parameters. Throws std::invalid_argument if alpha is
+        // empty or has a non-positive element.
+        explicit dirichlet_generator(std::vector<T> const& alpha)
+        {
+            this->alpha(alpha);
+        }
+
+        // This constructor creates a symmetric Dirichlet distribution of
+        // given dimension with all concentration parameters set to alpha.
+        dirichlet_generator(std::size_t dimension, T alpha)
+            : dirichlet_generator{std::vector<T>(dimension, alpha)}
+        {
+        }
+
+        // dimension returns the dimension of generated vectors.
+        std::size_t dimension() const
+        {
+            return alpha_.size();
+        }
+
+        // alpha returns the concentration parameters.
+        std::vector<T> const& alpha() const
+        {
+            return alpha_;
+        }
+
+        // alpha sets the concentration parameters. Storage is reused when
+        // the dimension does not grow, so updating the parameters for each
+        // document of a topic model does not allocate. Throws
+        // std::invalid_argument if alpha is empty or has a non-positive
+        // element.
+        void alpha(std::vector<T> const& alpha)
+        {
+            if (alpha.empty()) {
+                throw std::invalid_argument("Dirichlet distribution needs at least one component");
+            }
+            for (auto const a : alpha) {
+                if (!(a > 0)) {
+                    throw std::invalid_argument("concentration parameters must be positive");
+                }
+            }
+            alpha_ = alpha;
+            tabulate();
+        }
+
+        // generate writes count random vectors to the array out, which must
+        // have room for count * dimension() numbers. Each vector is stored
+        // contiguously, so out is a row-major count x dimension() matrix.
+        template<typename URNG>
+        void generate(T* out, std::size_t count, URNG& random)
+        {
+            constexpr std::size_t block = ziggurat_detail::bulk_block_size;
+
+            auto const dim = dimension();
+            auto const group = std::max(span_ / dim, std::size_t(1));
+
+            for (std::size_t done = 0; done < count; done += group) {
+                auto const rows = std::min(group, count - done);
+                auto const size = rows * dim;
+                auto const first = out + done * dim;
+
+                for (std::size_t offset = 0; offset < size; offset += block) {
+                    auto const cols = std::min(block, size - offset);
+                    generate_gammas(first + offset, cols, offset, random);
+                }
+
+                for (std::size_t row = 0; row < rows; row++) {
+                    if (boosted_) {
+                        apply_log_boosts(first + row * dim, log_boosts_.data() + row * dim, dim);
+                    }
+                    normalize(first + row * dim, dim);
+                }
+            }
+        }
+
+    private:
+        // tabulate lays out the per-component constants of the gamma kernel.
+        // Dimensions up to the block size are repeated to fill a block so
+        // that a block holds whole vectors. The tables are padded to a
+        // multiple of the block size with harmless constants so that the
+        // squeeze loop runs over a fixed number of elements.
+        void tabulate()
+        {
+            constexpr std::size_t block = ziggurat_detail::bulk_block_size;
+
+            auto const dim = dimension();
+
+            span_ = dim <= block ? block / dim * dim : dim;
+
+            auto const padded = (span_ + block - 1) / block * block;
+
+            samplers_.clear();
+            d_.assign(padded, 1);
+            c_.assign(padded, 0);
+            log_boosts_.assign(span_, 0);
+            boosted_ = false;
+
+            for (std::size_t i = 0; i < span_; i++) {
+                samplers_.emplace_back(alpha_[i % dim]);
+                d_[i] = samplers_[i].d();
+                c_[i] = samplers_[i].c();
+                boosted_ = boosted_ || samplers_[i].boosted();
+            }
+        }
+
+        // generate_gammas writes cols gamma random numbers to out. The shape
+        // of out[i] is the one tabulated at offset + i. If the shape is less
+        // than one, out[i] lacks the boost factor, whose logarithm is written
+        // to log_boosts_[offset + i].
+        template<typename URNG>
+        void generate_gammas(T* out, std::size_t cols, std::size_t offset, URNG& random)
+        {
+            constexpr std::size_t block = ziggurat_detail::bulk_block_size;
+
+            T normals[block];
+            T uniforms[block];
+            T samples[block];
+            bool accepts[block];
+
+            normal_.generate(normals, normals + cols, random);
+            for (std::size_t i = 0; i < cols; i++) {
+                uniforms[i] = ziggurat_detail::generate_uniform<T>(random);
+            }
+            for (std::size_t i = cols; i < block; i++) {
+                normals[i] = 0;
+                uniforms[i] = 0;
+            }
+
+            auto const d = d_.data() + offset;
+            auto const c = c_.data() + offset;
+
+            for (std::size_t i = 0; i < block; i++) {
+                auto const x = normals[i];
+                auto const v = 1 + c[i] * x;
+                auto const v3 = v * v * v;
+                auto const x2 = x * x;
+
+                samples[i] = d[i] * v3;
+                accepts[i] = (v > 0) & (uniforms[i] < 1 - T(0.0331) * x2 * x2);
+            }
+
+            for (std::size_t i = 0; i < cols; i++) {
+                if (!ZIGGURAT_LIKELY(accepts[i])) {
+                    samples[i] = samplers_[offset + i].finish_sample(random, normals[i], uniforms[i]);
+                }
+            }
+
+            // Only the components with shapes below one draw the uniform
+            // number for boosting, which matters for topic-model posteriors
+            // mixing sparse and dense components.
+            if (boosted_) {
+                auto const log_boosts = log_boosts_.data() + offset;
+
+                for (std::size_t i = 0; i < cols; i++) {
+                    auto const& sampler = samplers_[offset + i];
+                    if (sampler.boosted()) {
+                        auto const u = 1 - ziggurat_detail::generate_uniform<T>(random);
+                        log_boosts[i] = sampler.log_boost_factor(u);
+                    }
+                }
+            }
+
+            std::copy(samples, samples + cols, out);
+        }
+
+        // normalize divides a vector by the sum of its components. The sum
+        // is accumulated in independent lanes, which vectorizes without
+        // reassociating floating-point additions.
+        static void normalize(T* vec, std::size_t size)
+        {
+            constexpr std::size_t lanes = 8;
+
+            T partials[lanes] = {};
+            std::size_t i = 0;
+
+            for (; i + lanes <= size; i += lanes) {
+                for (std::size_t j = 0; j < lanes; j++) {
+                    partials[j] += vec[i + j];
+                }
+            }
+
+            T sum = 0;
+            for (std::size_t j = 0; j < lanes; j++) {
+                sum += partials[j];
+            }
+            for (; i < size; i++) {
+                sum += vec[i];
+            }
+
+            auto const scale = 1 / sum;
+            for (std::size_t j = 0; j < size; j++) {
+                vec[j] *= scale;
+            }
+        }
+
+        // apply_log_boosts multiplies the components of a vector by their
+        // boost factors exp(log_boosts[i]) divided by the largest one. The
+        // component with the largest boost keeps its positive unboosted
+        // value, so the vector does not vanish. Components with shapes of at
+        // least one have zero log boosts and share one scale factor.
+        static void apply_log_boosts(T* vec, T const* log_boosts, std::size_t size)
+        {
+            auto const max = *std::max_element(log_boosts, log_boosts + size);
+            auto const unboosted_scale = std::exp(-max);
+
+            for (std::size_t i = 0; i < size; i++) {
+                vec[i] *= log_boosts[i] == 0 ? unboosted_scale : std::exp(log_boosts[i] - max);
+            }
+        }
+
+        std::vector<T> alpha_;
+        std::size_t span_ = 0;
+        bool boosted_ = false;
+        std::vector<ziggurat_detail::marsaglia_tsang<T>> samplers_;
+        std::vector<T> d_;
+        std::vector<T> c_;
+        std::vector<T> log_boosts_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+}
+
+#undef ZIGGURAT_LIKELY
+
+#endif
@@ -0,0 +1,518 @@
+// Discrete Gaussian random integers built on the ziggurat normal distribution
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_DISCRETE_HPP
+#define INCLUDED_ZIGGURAT_DISCRETE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "ziggurat.hpp"
+
+#if defined(__GNUC__)
+# define ZIGGURAT_LIKELY(x) __builtin_expect((x), 1)
+#else
+# define ZIGGURAT_LIKELY(x) (x)
+#endif
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // discrete_gaussian_table_limit is the largest sigma for which the
+        // discrete Gaussian is sampled by searching a cumulative table. The
+        // table has about 20 sigma entries and its search slows down once
+        // it falls out of the L1 cache, while the rejection method costs
+        // about one normal and two uniform numbers regardless of sigma. The
+        // limit keeps the padded table within 64 KiB.
+        constexpr double discrete_gaussian_table_limit = 256;
+
+        // discrete_gaussian_tail_cut is the number of sigmas covered by the
+        // cumulative table. Integers farther from the center have
+        // probabilities below 2^-64 and are not representable in the table.
+        constexpr double discrete_gaussian_tail_cut = 10;
+
+        // discrete_gaussian_sampler samples integers x with probabilities
+        // proportional to exp(-(x - c)^2 / 2 sigma^2). Integers are sampled
+        // relative to floor(c), so only the fractional part of the center
+        // enters the computation.
+        //
+        // A small sigma uses a cumulative distribution table (CDT) of 63-bit
+        // fixed-point probabilities searched by a branch-free binary search.
+        // A large sigma uses rejection from a continuous envelope: a normal
+        // density split at the center by a plateau of width one. A ziggurat
+        // normal number rounded to the nearest integer is accepted with
+        // probability exp(-d), which is tested against 1 - d first so that
+        // the exponential is rarely computed.
+        template<typename IntType>
+        class discrete_gaussian_sampler
+        {
+        public:
+            discrete_gaussian_sampler(double center, double sigma)
+                : base_{IntType(std::floor(center))}
+                , offset_{center - std::floor(center)}
+                , sigma_{sigma}
+                , inv_two_variance_{1 / (2 * sigma * sigma)}
+                , plateau_{1 / (1 + sigma * 2.5066282746310002)}
+            {
+                if (sigma <= discrete_gaussian_table_limit) {
+                    tabulate();
+                }
+            }
+
+            // operator() returns a discrete Gaussian random integer.
+            template<typename URNG>
+            inline IntType operator()(URNG& random)
+            {
+                if (!table_.empty()) {
+                    return base_ + IntType(lowest_ + search(generate_bits<63>(random)));
+                }
+                return base_ + IntType(sample(random));
+            }
+
+            // generate fills the range [first, last) with discrete Gaussian
+            // random integers. The table search runs one bisection step
+            // across a block of numbers at a time, so the lookups of
+            // different numbers overlap. The rejection method spends its
+            // time drawing random numbers and samples one by one; a
+            // block-wise version measured slower.
+            template<typename ForwardIterator, typename URNG>
+            void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+            {
+                if (table_.empty()) {
+                    for (; first != last; ++first) {
+                        *first = base_ + IntType(sample(random));
+                    }
+                    return;
+                }
+
+                auto remaining = std::size_t(std::distance(first, last));
+
+                while (remaining > 0) {
+                    auto const count = std::min(remaining, bulk_block_size);
+                    first = generate_from_table(first, count, random);
+                    remaining -= count;
+                }
+            }
+
+        private:
+            // tabulate builds the table of cumulative probabilities. The
+            // table is padded to a power of two with thresholds no random
+            // number reaches, so the binary search takes a fixed number of
+            // steps.
+            void tabulate()
+            {
+                auto const reach = std::ceil(discrete_gaussian_tail_cut * sigma_);
+
+                lowest_ = -std::int64_t(reach);
+
+                auto const size = std::size_t(2 * reach + 2);
+                std::vector<double> weights(size);
+                double total = 0;
+
+                for (std::size_t i = 0; i < size; i++) {
+                    auto const dx = double(lowest_ + std::int64_t(i)) - offset_;
+                    weights[i] = std::exp(-dx * dx * inv_two_variance_);
+                    total += weights[i];
+                }
+
+                std::size_t padded = 1;
+                while (padded < size) {
+                    padded *= 2;
+                }
+
+                // Threshold i is the 63-bit probability of the integers up to
+                // lowest + i. The search counts thresholds not exceeding a
+                // random number, which is the offset of the sampled integer.
+                table_.assign(padded, std::numeric_limits<std::uint64_t>::max());
+
+                double cumulative = 0;
+                for (std::size_t i = 0; i + 1 < size; i++) {
+                    cumulative += weights[i];
+                    table_[i] = std::uint64_t(std::ldexp(cumulative / total, 63));
+                }
+            }
+
+            // search returns the number of thresholds not exceeding r.
+            inline std::int64_t search(std::uint64_t r) const
+            {
+                std::size_t pos = 0;
+                for (auto half = table_.size() / 2; half > 0; half /= 2) {
+                    pos += (table_[pos + half - 1] <= r ? half : 0);
+                }
+                return std::int64_t(pos);
+            }
+
+            template<typename OutputIterator, typename URNG>
+            OutputIterator generate_from_table(OutputIterator out, std::size_t count, URNG& random)
+            {
+                std::uint64_t bits[bulk_block_size];
+                std::size_t positions[bulk_block_size];
+
+                for (std::size_t i = 0; i < count; i++) {
+                    bits[i] = generate_bits<63>(random);
+                    positions[i] = 0;
+                }
+
+                // Bisection steps are interleaved across the block so that
+                // the table lookups of different numbers overlap.
+                auto const table = table_.data();
+
+                for (auto half = table_.size() / 2; half > 0; half /= 2) {
+                    for (std::size_t i = 0; i < count; i++) {
+                        positions[i] += (table[positions[i] + half - 1] <= bits[i] ? half : 0);
+                    }
+                }
+
+                for (std::size_t i = 0; i < count; i++) {
+                    *out = base_ + IntType(lowest_ + std::int64_t(positions[i]));
+                    ++out;
+                }
+
+                return out;
+            }
+
+            // sample returns an integer relative to floor(c) by rejection.
+            template<typename URNG>
+            double sample(URNG& random)
+            {
+                for (;;) {
+                    auto const choice = generate_uniform<double>(random);
+                    auto const z = (choice < plateau_ ? 0 : normal_(random));
+                    auto const y = envelope_point(z, choice);
+                    auto const x = round_to_integer(offset_ + y);
+                    auto const d = deficit(x, y);
+                    auto const u = generate_uniform<double>(random);
+
+                    if (ZIGGURAT_LIKELY(u < 1 - d) || u < std::exp(-d)) {
+                        return x;
+                    }
+                }
+            }
+
+            // envelope_point maps a standard normal number z and a uniform
+            // number choice to a point y relative to the center distributed
+            // with the envelope density. The plateau [-1/2, 1/2) is chosen
+            // with probability plateau and the two normal halves are moved
+            // apart by the plateau otherwise.
+            inline double envelope_point(double z, double choice) const
+            {
+                auto const tail = std::fabs(z) * sigma_ + 0.5;
+                auto const flat = choice / plateau_ - 0.5;
+                return choice < plateau_ ? flat : (z < 0 ? -tail : tail);
+            }
+
+            // deficit returns d such that exp(-d) is the ratio of the target
+            // weight of integer x to the envelope density at y.
+            inline double deficit(double x, double y) const
+            {
+                auto const dx = x - offset_;
+                auto const t = std::max(std::fabs(y) - 0.5, 0.0);
+                return (dx * dx - t * t) * inv_two_variance_;
+            }
+
+            // round_to_integer returns the integer nearest to v.
+            static inline double round_to_integer(double v)
+            {
+                auto const shifted = v + 0.5;
+                auto const truncated = double(std::int64_t(shifted));
+                return truncated - (truncated > shifted ? 1 : 0);
+            }
+
+            IntType base_;
+            double offset_;
+            double sigma_;
+            double inv_two_variance_;
+            double plateau_;
+            std::int64_t lowest_ = 0;
+            std::vector<std::uint64_t> table_;
+            ziggurat_normal_distribution<double> normal_;
+        };
+    }
+
+    // ziggurat_discrete_gaussian_distribution generates integers x with
+    // probabilities proportional to exp(-(x - c)^2 / 2 sigma^2) for a real
+    // center c and a width sigma. This is the discrete Gaussian over the
+    // integers used by lattice-based cryptography and by differential
+    // privacy mechanisms. Probabilities are computed in double precision and
+    // the sampling time depends on the sampled value, so the distribution is
+    // meant for prototypes and simulations, not for implementations that
+    // must resist timing attacks.
+    template<typename IntType = int>
+    class ziggurat_discrete_gaussian_distribution
+    {
+    public:
+        // result_type is an alias of IntType.
+        using result_type = IntType;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_discrete_gaussian_distribution;
+
+            // Default constructor initializes center to 0 and sigma to 1.
+            param_type() = default;
+
+            // This constructor initializes the center and the width to given
+            // values.
+            explicit param_type(double center, double sigma = 1)
+                : center_{center}, sigma_{sigma}
+            {
+            }
+
+            // center returns the center parameter.
+            inline double center() const
+            {
+                return center_;
+            }
+
+            // sigma returns the width parameter.
+            inline double sigma() const
+            {
+                return sigma_;
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.center_ == p2.center_ && p1.sigma_ == p2.sigma_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes center and sigma to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    Char const space = os.widen(' ');
+                    os << param.center_ << space << param.sigma_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads center and sigma from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.center_ >> tmp.sigma_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            double center_ = 0;
+            double sigma_ = 1;
+        };
+
+        // Default constructor creates a discrete Gaussian distribution with
+        // center 0 and sigma 1.
+        ziggurat_discrete_gaussian_distribution()
+            : ziggurat_discrete_gaussian_distribution{param_type{}}
+        {
+        }
+
+        // This constructor creates a discrete Gaussian distribution with
+        // given center and width.
+        explicit ziggurat_discrete_gaussian_distribution(double center, double sigma = 1)
+            : ziggurat_discrete_gaussian_distribution{param_type{center, sigma}}
+        {
+        }
+
+        // This constructor creates a discrete Gaussian distribution having
+        // given parameters.
+        explicit ziggurat_discrete_gaussian_distribution(param_type const& param)
+            : param_{param}, sampler_{param.center(), param.sigma()}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated random integer with the preconfigured parameters.
+        template<typename URNG>
+        inline IntType operator()(URNG& random)
+        {
+            return sampler_(random);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated random integer with given
+        // parameters. A small sigma builds a table on each call, so use a
+        // distribution object per parameter set where possible.
+        template<typename URNG>
+        inline IntType operator()(URNG& random, param_type const& param)
+        {
+            if (param == param_) {
+                return sampler_(random);
+            }
+            ziggurat_detail::discrete_gaussian_sampler<IntType> sampler{param.center(), param.sigma()};
+            return sampler(random);
+        }
+
+        // generate fills the range [first, last) with random integers with
+        // the preconfigured parameters. The generated sequence differs from
+        // the one generated by repeated operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            sampler_.generate(first, last, random);
+        }
+
+        // generate fills the range [first, last) with random integers with
+        // given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            ziggurat_detail::discrete_gaussian_sampler<IntType> sampler{param.center(), param.sigma()};
+            sampler.generate(first, last, random);
+        }
+
+        // center returns the center parameter of this distribution.
+        double center() const
+        {
+            return param_.center();
+        }
+
+        // sigma returns the width parameter of this distribution.
+        double sigma() const
+        {
+            return param_.sigma();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+            sampler_ = ziggurat_detail::discrete_gaussian_sampler<IntType>{param.center(), param.sigma()};
+        }
+
+        // min returns the smallest representable integer.
+        result_type min() const
+        {
+            return std::numeric_limits<result_type>::min();
+        }
+
+        // max returns the largest representable integer.
+        result_type max() const
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+    private:
+        param_type param_;
+        ziggurat_detail::discrete_gaussian_sampler<IntType> sampler_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename IntType>
+    bool operator==(
+        ziggurat_discrete_gaussian_distribution<IntType> const& d1,
+        ziggurat_discrete_gaussian_distribution<IntType> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    template<typename IntType>
+    bool operator!=(
+        ziggurat_discrete_gaussian_distribution<IntType> const& d1,
+        ziggurat_discrete_gaussian_distribution<IntType> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output operator writes center and sigma parameters to a stream.
+    template<typename Char, typename Tr, typename IntType>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_discrete_gaussian_distribution<IntType> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input operator reads center and sigma parameters from a stream.
+    template<typename Char, typename Tr, typename IntType>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_discrete_gaussian_distribution<IntType>& dist
+    )
+    {
+        typename ziggurat_discrete_gaussian_distribution<IntType>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+}
+
+#undef ZIGGURAT_LIKELY
+
+#endif
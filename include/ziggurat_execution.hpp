@@ -0,0 +1,215 @@
+// Execution-policy overloads of normal random number generation
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_EXECUTION_HPP
+#define INCLUDED_ZIGGURAT_EXECUTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__has_include) && __cplusplus >= 201703L
+# if __has_include(<execution>)
+#  include <execution>
+# endif
+#endif
+
+#if defined(__cpp_lib_execution) && !defined(ZIGGURAT_NO_STD_EXECUTION)
+# define ZIGGURAT_HAS_STD_EXECUTION 1
+# include <algorithm>
+# include <numeric>
+#endif
+
+#include "ziggurat.hpp"
+#include "ziggurat_parallel.hpp"
+
+
+namespace cxx
+{
+    // cxx::execution provides the execution policies accepted by
+    // generate_normal. These are the standard policies if the standard
+    // library supports parallel algorithms. Otherwise they are stand-ins
+    // with the same names, and generate_normal runs blocks on its own threads.
+    // Define ZIGGURAT_NO_STD_EXECUTION to always use the stand-ins.
+    namespace execution
+    {
+#if defined(ZIGGURAT_HAS_STD_EXECUTION)
+        using std::execution::sequenced_policy;
+        using std::execution::parallel_policy;
+        using std::execution::parallel_unsequenced_policy;
+        using std::execution::seq;
+        using std::execution::par;
+        using std::execution::par_unseq;
+
+        template<typename T>
+        struct is_execution_policy : std::is_execution_policy<T>
+        {
+        };
+#else
+        struct sequenced_policy
+        {
+        };
+
+        struct parallel_policy
+        {
+        };
+
+        struct parallel_unsequenced_policy
+        {
+        };
+
+        constexpr sequenced_policy seq{};
+        constexpr parallel_policy par{};
+        constexpr parallel_unsequenced_policy par_unseq{};
+
+        template<typename T>
+        struct is_execution_policy : std::integral_constant<
+            bool,
+            std::is_same<T, sequenced_policy>::value ||
+            std::is_same<T, parallel_policy>::value ||
+            std::is_same<T, parallel_unsequenced_policy>::value
+        >
+        {
+        };
+#endif
+    }
+
+    namespace ziggurat_detail
+    {
+        // enable_if_execution_policy removes an overload from overload
+        // resolution unless ExecutionPolicy is an execution policy.
+        template<typename ExecutionPolicy>
+        using enable_if_execution_policy = typename std::enable_if<
+            execution::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+        >::type;
+
+#if defined(ZIGGURAT_HAS_STD_EXECUTION)
+        // for_each_block invokes fill_block(i) for each i in [0, block_count)
+        // with the standard parallel algorithm.
+        template<typename ExecutionPolicy, typename F>
+        void for_each_block(ExecutionPolicy&& policy, std::size_t block_count, F fill_block)
+        {
+            std::vector<std::size_t> blocks(block_count);
+            std::iota(blocks.begin(), blocks.end(), std::size_t(0));
+            std::for_each(std::forward<ExecutionPolicy>(policy), blocks.begin(), blocks.end(), fill_block);
+        }
+#else
+        // run_blocks invokes fill_block(i) for each i in [0, block_count) in
+        // the calling thread.
+        template<typename F>
+        void run_blocks(std::true_type, std::size_t block_count, F fill_block)
+        {
+            for (std::size_t block = 0; block < block_count; block++) {
+                fill_block(block);
+            }
+        }
+
+        // run_blocks invokes fill_block(i) for each i in [0, block_count)
+        // using the hardware concurrency.
+        template<typename F>
+        void run_blocks(std::false_type, std::size_t block_count, F fill_block)
+        {
+            run_parallel(block_count, resolve_thread_count(0, block_count), fill_block);
+        }
+
+        // for_each_block invokes fill_block(i) for each i in [0, block_count),
+        // sequentially under the sequenced policy and in parallel otherwise.
+        template<typename ExecutionPolicy, typename F>
+        void for_each_block(ExecutionPolicy&&, std::size_t block_count, F fill_block)
+        {
+            using is_sequenced = std::is_same<
+                typename std::decay<ExecutionPolicy>::type, execution::sequenced_policy
+            >;
+            run_blocks(is_sequenced{}, block_count, fill_block);
+        }
+#endif
+    }
+
+    // generate_normal fills the range [first, last) with normal random
+    // numbers with given parameters under an execution policy. The range is
+    // partitioned into the same blocks as parallel_generate, each filled by
+    // the bulk kernel with an independently seeded Engine, so the result is
+    // identical to parallel_generate and does not depend on the policy.
+    template<
+        typename Engine = std::mt19937_64,
+        typename ExecutionPolicy,
+        typename RandomAccessIterator,
+        typename = ziggurat_detail::enable_if_execution_policy<ExecutionPolicy>
+    >
+    void generate_normal(
+        ExecutionPolicy&& policy,
+        RandomAccessIterator first,
+        RandomAccessIterator last,
+        std::uint64_t seed,
+        typename ziggurat_normal_distribution<
+            typename std::iterator_traits<RandomAccessIterator>::value_type
+        >::param_type const& param
+    )
+    {
+        constexpr std::size_t block_size = ziggurat_detail::parallel_block_size;
+
+        auto const size = std::size_t(last - first);
+        auto const block_count = (size + block_size - 1) / block_size;
+
+        auto fill_block = [&](std::size_t block) {
+            ziggurat_detail::fill_parallel_block<Engine>(first, size, block, seed, param);
+        };
+
+        ziggurat_detail::for_each_block(
+            std::forward<ExecutionPolicy>(policy), block_count, fill_block
+        );
+    }
+
+    // generate_normal fills the range [first, last) with standard normal
+    // random numbers under an execution policy.
+    template<
+        typename Engine = std::mt19937_64,
+        typename ExecutionPolicy,
+        typename RandomAccessIterator,
+        typename = ziggurat_detail::enable_if_execution_policy<ExecutionPolicy>
+    >
+    void generate_normal(
+        ExecutionPolicy&& policy,
+        RandomAccessIterator first,
+        RandomAccessIterator last,
+        std::uint64_t seed
+    )
+    {
+        using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        using param_type = typename ziggurat_normal_distribution<value_type>::param_type;
+
+        generate_normal<Engine>(
+            std::forward<ExecutionPolicy>(policy), first, last, seed, param_type{}
+        );
+    }
+}
+
+#endif
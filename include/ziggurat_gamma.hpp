@@ -0,0 +1,1412 @@
+// Gamma-family random number generation built on the ziggurat normal distribution
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_GAMMA_HPP
+#define INCLUDED_ZIGGURAT_GAMMA_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+
+#include "ziggurat.hpp"
+
+#if defined(__GNUC__)
+# define ZIGGURAT_LIKELY(x) __builtin_expect((x), 1)
+# define ZIGGURAT_NOINLINE __attribute__((noinline))
+#else
+# define ZIGGURAT_LIKELY(x) (x)
+# define ZIGGURAT_NOINLINE
+#endif
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // marsaglia_tsang samples gamma random numbers with given shape and
+        // unit scale using the squeeze method of Marsaglia and Tsang (2000)
+        // driven by the ziggurat normal distribution. A shape less than one
+        // is boosted: G(a) = G(a + 1) U^(1/a).
+        template<typename T>
+        class marsaglia_tsang
+        {
+        public:
+            explicit marsaglia_tsang(T shape)
+                : boost_{shape < 1}
+                , d_{(shape < 1 ? shape + 1 : shape) - T(1) / 3}
+                , c_{1 / std::sqrt(9 * d_)}
+                , inv_shape_{1 / shape}
+            {
+            }
+
+            // operator() returns a gamma random number.
+            template<typename URNG>
+            inline T operator()(URNG& random)
+            {
+                auto const x = sample(random);
+                if (boost_) {
+                    return x * boost_factor(1 - generate_uniform<T>(random));
+                }
+                return x;
+            }
+
+            // generate fills the range [first, last) with gamma random numbers
+            // multiplied by scale. The numbers are generated block by block
+            // by generate_block.
+            template<typename ForwardIterator, typename URNG>
+            void generate(ForwardIterator first, ForwardIterator last, URNG& random, T scale)
+            {
+                constexpr std::size_t block_size = bulk_block_size;
+
+                T samples[block_size];
+                T boosts[block_size];
+
+                auto remaining = std::size_t(std::distance(first, last));
+
+                while (remaining > 0) {
+                    auto const count = std::min(remaining, block_size);
+
+                    generate_block(samples, boosts, count, random);
+
+                    if (boost_) {
+                        for (std::size_t i = 0; i < count; i++) {
+                            samples[i] *= boost_factor(boosts[i]);
+                        }
+                    }
+
+                    for (std::size_t i = 0; i < count; i++) {
+                        *first = scale * samples[i];
+                        ++first;
+                    }
+
+                    remaining -= count;
+                }
+            }
+
+            // split_sample returns a gamma random number G without the boost
+            // and stores the logarithm of the boost factor, or zero if the
+            // shape is at least one, to log_boost. The gamma random number is
+            // G exp(log_boost). Keeping the factor as a logarithm avoids the
+            // underflow of the product, which is common for shapes well below
+            // one.
+            template<typename URNG>
+            inline T split_sample(URNG& random, T& log_boost)
+            {
+                auto const x = sample(random);
+                log_boost = boost_ ? log_boost_factor(1 - generate_uniform<T>(random)) : 0;
+                return x;
+            }
+
+            // generate_split is split_sample for count <= bulk_block_size
+            // numbers written to samples and log_boosts. It consumes random
+            // numbers as generate does.
+            template<typename URNG>
+            void generate_split(T* samples, T* log_boosts, std::size_t count, URNG& random)
+            {
+                generate_block(samples, log_boosts, count, random);
+
+                if (boost_) {
+                    for (std::size_t i = 0; i < count; i++) {
+                        log_boosts[i] = log_boost_factor(log_boosts[i]);
+                    }
+                } else {
+                    std::fill(log_boosts, log_boosts + count, T(0));
+                }
+            }
+
+            // boosted returns true if the shape is less than one and samples
+            // are multiplied by boost_factor.
+            inline bool boosted() const
+            {
+                return boost_;
+            }
+
+            // d and c return the constants of the squeeze method. A candidate
+            // for a normal number x is d (1 + c x)^3.
+            inline T d() const
+            {
+                return d_;
+            }
+
+            inline T c() const
+            {
+                return c_;
+            }
+
+            // finish_sample completes a bulk candidate that failed the squeeze
+            // test with the logarithmic test, and resamples if that fails too.
+            template<typename URNG>
+            ZIGGURAT_NOINLINE
+            T finish_sample(URNG& random, T x, T u)
+            {
+                auto const v = 1 + c_ * x;
+                if (v > 0) {
+                    auto const v3 = v * v * v;
+                    if (std::log(u) < x * x / 2 + d_ * (1 - v3 + std::log(v3))) {
+                        return d_ * v3;
+                    }
+                }
+                return sample(random);
+            }
+
+            // boost_factor returns u^(1/shape) for a uniform number u in
+            // (0, 1].
+            inline T boost_factor(T u) const
+            {
+                return std::exp(log_boost_factor(u));
+            }
+
+            // log_boost_factor returns log(u) / shape for a uniform number u
+            // in (0, 1].
+            inline T log_boost_factor(T u) const
+            {
+                return std::log(u) * inv_shape_;
+            }
+
+        private:
+            // generate_block writes count <= bulk_block_size gamma random
+            // numbers without the boost to samples. Candidates are computed
+            // for a block of normal and uniform numbers at once in a
+            // branch-free loop and only rejected ones are resampled one by
+            // one. If the shape is less than one, count uniform numbers in
+            // (0, 1] for the boost are then written to boosts.
+            template<typename URNG>
+            void generate_block(T* samples, T* boosts, std::size_t count, URNG& random)
+            {
+                constexpr std::size_t block_size = bulk_block_size;
+
+                T normals[block_size];
+                T uniforms[block_size];
+                bool accepts[block_size];
+
+                normal_.generate(normals, normals + count, random);
+                for (std::size_t i = 0; i < count; i++) {
+                    uniforms[i] = generate_uniform<T>(random);
+                }
+
+                // Squeeze test, which accepts about 98% of candidates.
+                for (std::size_t i = 0; i < count; i++) {
+                    auto const x = normals[i];
+                    auto const v = 1 + c_ * x;
+                    auto const v3 = v * v * v;
+                    auto const x2 = x * x;
+
+                    samples[i] = d_ * v3;
+                    accepts[i] = (v > 0) & (uniforms[i] < 1 - T(0.0331) * x2 * x2);
+                }
+
+                for (std::size_t i = 0; i < count; i++) {
+                    if (!ZIGGURAT_LIKELY(accepts[i])) {
+                        samples[i] = finish_sample(random, normals[i], uniforms[i]);
+                    }
+                }
+
+                if (boost_) {
+                    for (std::size_t i = 0; i < count; i++) {
+                        boosts[i] = 1 - generate_uniform<T>(random);
+                    }
+                }
+            }
+
+            template<typename URNG>
+            inline T sample(URNG& random)
+            {
+                for (;;) {
+                    auto const x = normal_(random);
+                    auto const v = 1 + c_ * x;
+                    if (v <= 0) {
+                        continue;
+                    }
+
+                    auto const v3 = v * v * v;
+                    auto const u = generate_uniform<T>(random);
+                    auto const x2 = x * x;
+
+                    if (ZIGGURAT_LIKELY(u < 1 - T(0.0331) * x2 * x2)) {
+                        return d_ * v3;
+                    }
+                    if (std::log(u) < x2 / 2 + d_ * (1 - v3 + std::log(v3))) {
+                        return d_ * v3;
+                    }
+                }
+            }
+
+            bool boost_;
+            T d_;
+            T c_;
+            T inv_shape_;
+            ziggurat_normal_distribution<T> normal_;
+        };
+
+        // chi_squared_sum_limit is the largest integer degrees of freedom for
+        // which chi-squared numbers are sampled as sums of squared normals
+        // instead of through the gamma distribution. A gamma number costs
+        // about two normal numbers, so summing more terms does not pay off.
+        constexpr unsigned chi_squared_sum_limit = 2;
+
+        // chi_squared_sampler samples chi-squared random numbers with given
+        // degrees of freedom n. Small integer n uses the sum of n squared
+        // normals and other n uses 2 G(n/2).
+        template<typename T>
+        class chi_squared_sampler
+        {
+        public:
+            explicit chi_squared_sampler(T n)
+                : terms_{is_sum_terms(n) ? unsigned(n) : 0}, gamma_{n / 2}
+            {
+            }
+
+            // operator() returns a chi-squared random number.
+            template<typename URNG>
+            inline T operator()(URNG& random)
+            {
+                if (terms_ == 0) {
+                    return 2 * gamma_(random);
+                }
+
+                T sum = 0;
+                for (unsigned i = 0; i < terms_; i++) {
+                    auto const z = normal_(random);
+                    sum += z * z;
+                }
+                return sum;
+            }
+
+            // generate fills the range [first, last) with chi-squared random
+            // numbers using the bulk normal or gamma kernel.
+            template<typename ForwardIterator, typename URNG>
+            void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+            {
+                if (terms_ == 0) {
+                    gamma_.generate(first, last, random, 2);
+                    return;
+                }
+
+                constexpr std::size_t block_size = bulk_block_size;
+
+                T normals[block_size * chi_squared_sum_limit];
+
+                auto remaining = std::size_t(std::distance(first, last));
+
+                while (remaining > 0) {
+                    auto const count = std::min(remaining, block_size);
+
+                    normal_.generate(normals, normals + count * terms_, random);
+
+                    for (std::size_t i = 0; i < count; i++) {
+                        T sum = 0;
+                        for (unsigned j = 0; j < terms_; j++) {
+                            auto const z = normals[i * terms_ + j];
+                            sum += z * z;
+                        }
+                        *first = sum;
+                        ++first;
+                    }
+
+                    remaining -= count;
+                }
+            }
+
+        private:
+            static bool is_sum_terms(T n)
+            {
+                return n >= 1 && n <= T(chi_squared_sum_limit) && n == std::floor(n);
+            }
+
+            unsigned terms_;
+            marsaglia_tsang<T> gamma_;
+            ziggurat_normal_distribution<T> normal_;
+        };
+    }
+
+    // ziggurat_gamma_distribution generates gamma random numbers using the
+    // method of Marsaglia and Tsang with the ziggurat normal distribution as
+    // the normal source. It is a drop-in replacement for
+    // std::gamma_distribution.
+    template<typename T>
+    class ziggurat_gamma_distribution
+    {
+    public:
+        // result_type is an alias of T.
+        using result_type = T;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_gamma_distribution;
+
+            // Default constructor initializes alpha and beta to 1.
+            param_type() = default;
+
+            // This constructor initializes the shape alpha and the scale beta
+            // to given values.
+            explicit param_type(result_type alpha, result_type beta = 1)
+                : alpha_{alpha}, beta_{beta}
+            {
+            }
+
+            // alpha returns the shape parameter.
+            inline result_type alpha() const
+            {
+                return alpha_;
+            }
+
+            // beta returns the scale parameter.
+            inline result_type beta() const
+            {
+                return beta_;
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.alpha_ == p2.alpha_ && p1.beta_ == p2.beta_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes alpha and beta to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    Char const space = os.widen(' ');
+                    os << param.alpha_ << space << param.beta_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads alpha and beta from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.alpha_ >> tmp.beta_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            result_type alpha_ = 1;
+            result_type beta_ = 1;
+        };
+
+        // Default constructor creates a gamma distribution with alpha = 1 and
+        // beta = 1.
+        ziggurat_gamma_distribution()
+            : ziggurat_gamma_distribution{param_type{}}
+        {
+        }
+
+        // This constructor creates a gamma distribution with given shape and
+        // scale.
+        explicit ziggurat_gamma_distribution(result_type alpha, result_type beta = 1)
+            : ziggurat_gamma_distribution{param_type{alpha, beta}}
+        {
+        }
+
+        // This constructor creates a gamma distribution having given
+        // parameters.
+        explicit ziggurat_gamma_distribution(param_type const& param)
+            : param_{param}, sampler_{param.alpha()}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated gamma random number with the preconfigured parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random)
+        {
+            return param_.beta() * sampler_(random);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated gamma random number with given
+        // parameters. The shape-dependent constants are recomputed unless
+        // the shape is the preconfigured one.
+        template<typename URNG>
+        inline T operator()(URNG& random, param_type const& param)
+        {
+            if (param.alpha() == param_.alpha()) {
+                return param.beta() * sampler_(random);
+            }
+            ziggurat_detail::marsaglia_tsang<T> sampler{param.alpha()};
+            return param.beta() * sampler(random);
+        }
+
+        // generate fills the range [first, last) with gamma random numbers
+        // with the preconfigured parameters. The shape-dependent constants
+        // are shared by the batch and normals are generated by the bulk
+        // ziggurat kernel, so this is faster than invoking the distribution
+        // for each element. The generated sequence differs from the one
+        // generated by repeated operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            sampler_.generate(first, last, random, param_.beta());
+        }
+
+        // generate fills the range [first, last) with gamma random numbers
+        // with given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            ziggurat_detail::marsaglia_tsang<T> sampler{param.alpha()};
+            sampler.generate(first, last, random, param.beta());
+        }
+
+        // alpha returns the shape parameter of this distribution.
+        result_type alpha() const
+        {
+            return param_.alpha();
+        }
+
+        // beta returns the scale parameter of this distribution.
+        result_type beta() const
+        {
+            return param_.beta();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+            sampler_ = ziggurat_detail::marsaglia_tsang<T>{param.alpha()};
+        }
+
+        // min returns 0.
+        result_type min() const
+        {
+            return 0;
+        }
+
+        // max returns +infinity.
+        result_type max() const
+        {
+            return std::numeric_limits<result_type>::infinity();
+        }
+
+    private:
+        param_type param_;
+        ziggurat_detail::marsaglia_tsang<T> sampler_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename T>
+    bool operator==(
+        ziggurat_gamma_distribution<T> const& d1,
+        ziggurat_gamma_distribution<T> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    template<typename T>
+    bool operator!=(
+        ziggurat_gamma_distribution<T> const& d1,
+        ziggurat_gamma_distribution<T> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output operator writes alpha and beta parameters to a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_gamma_distribution<T> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input operator reads alpha and beta parameters from a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_gamma_distribution<T>& dist
+    )
+    {
+        typename ziggurat_gamma_distribution<T>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+
+    // ziggurat_chi_squared_distribution generates chi-squared random numbers
+    // using the ziggurat normal distribution. Small integer degrees of freedom
+    // use sums of squared normals and others use the gamma distribution. It
+    // is a drop-in replacement for std::chi_squared_distribution.
+    template<typename T>
+    class ziggurat_chi_squared_distribution
+    {
+    public:
+        // result_type is an alias of T.
+        using result_type = T;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_chi_squared_distribution;
+
+            // Default constructor initializes n to 1.
+            param_type() = default;
+
+            // This constructor initializes the degrees of freedom n to given
+            // value.
+            explicit param_type(result_type n)
+                : n_{n}
+            {
+            }
+
+            // n returns the degrees of freedom.
+            inline result_type n() const
+            {
+                return n_;
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.n_ == p2.n_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes n to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    os << param.n_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads n from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.n_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            result_type n_ = 1;
+        };
+
+        // Default constructor creates a chi-squared distribution with n = 1.
+        ziggurat_chi_squared_distribution()
+            : ziggurat_chi_squared_distribution{param_type{}}
+        {
+        }
+
+        // This constructor creates a chi-squared distribution with given
+        // degrees of freedom.
+        explicit ziggurat_chi_squared_distribution(result_type n)
+            : ziggurat_chi_squared_distribution{param_type{n}}
+        {
+        }
+
+        // This constructor creates a chi-squared distribution having given
+        // parameters.
+        explicit ziggurat_chi_squared_distribution(param_type const& param)
+            : param_{param}, sampler_{param.n()}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated chi-squared random number with the preconfigured
+        // parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random)
+        {
+            return sampler_(random);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated chi-squared random number with
+        // given parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random, param_type const& param)
+        {
+            if (param == param_) {
+                return sampler_(random);
+            }
+            ziggurat_detail::chi_squared_sampler<T> sampler{param.n()};
+            return sampler(random);
+        }
+
+        // generate fills the range [first, last) with chi-squared random
+        // numbers with the preconfigured parameters using the bulk normal or
+        // gamma kernel. The generated sequence differs from the one generated
+        // by repeated operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            sampler_.generate(first, last, random);
+        }
+
+        // generate fills the range [first, last) with chi-squared random
+        // numbers with given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            ziggurat_detail::chi_squared_sampler<T> sampler{param.n()};
+            sampler.generate(first, last, random);
+        }
+
+        // n returns the degrees of freedom of this distribution.
+        result_type n() const
+        {
+            return param_.n();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+            sampler_ = ziggurat_detail::chi_squared_sampler<T>{param.n()};
+        }
+
+        // min returns 0.
+        result_type min() const
+        {
+            return 0;
+        }
+
+        // max returns +infinity.
+        result_type max() const
+        {
+            return std::numeric_limits<result_type>::infinity();
+        }
+
+    private:
+        param_type param_;
+        ziggurat_detail::chi_squared_sampler<T> sampler_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename T>
+    bool operator==(
+        ziggurat_chi_squared_distribution<T> const& d1,
+        ziggurat_chi_squared_distribution<T> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    template<typename T>
+    bool operator!=(
+        ziggurat_chi_squared_distribution<T> const& d1,
+        ziggurat_chi_squared_distribution<T> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output operator writes the n parameter to a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_chi_squared_distribution<T> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input operator reads the n parameter from a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_chi_squared_distribution<T>& dist
+    )
+    {
+        typename ziggurat_chi_squared_distribution<T>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+
+    // ziggurat_student_t_distribution generates Student's t random numbers
+    // as Z / sqrt(V / n) where Z is a ziggurat normal number and V is a
+    // chi-squared number with n degrees of freedom. It is a drop-in
+    // replacement for std::student_t_distribution.
+    template<typename T>
+    class ziggurat_student_t_distribution
+    {
+    public:
+        // result_type is an alias of T.
+        using result_type = T;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_student_t_distribution;
+
+            // Default constructor initializes n to 1.
+            param_type() = default;
+
+            // This constructor initializes the degrees of freedom n to given
+            // value.
+            explicit param_type(result_type n)
+                : n_{n}
+            {
+            }
+
+            // n returns the degrees of freedom.
+            inline result_type n() const
+            {
+                return n_;
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.n_ == p2.n_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes n to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    os << param.n_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads n from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.n_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            result_type n_ = 1;
+        };
+
+        // Default constructor creates a t distribution with n = 1.
+        ziggurat_student_t_distribution()
+            : ziggurat_student_t_distribution{param_type{}}
+        {
+        }
+
+        // This constructor creates a t distribution with given degrees of
+        // freedom.
+        explicit ziggurat_student_t_distribution(result_type n)
+            : ziggurat_student_t_distribution{param_type{n}}
+        {
+        }
+
+        // This constructor creates a t distribution having given parameters.
+        explicit ziggurat_student_t_distribution(param_type const& param)
+            : param_{param}, chi_squared_{param.n()}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated t random number with the preconfigured parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random)
+        {
+            return sample(random, param_.n(), chi_squared_);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated t random number with given
+        // parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random, param_type const& param)
+        {
+            if (param == param_) {
+                return sample(random, param_.n(), chi_squared_);
+            }
+            ziggurat_detail::chi_squared_sampler<T> chi_squared{param.n()};
+            return sample(random, param.n(), chi_squared);
+        }
+
+        // generate fills the range [first, last) with t random numbers with
+        // the preconfigured parameters. Normal and chi-squared numbers are
+        // generated in blocks by the bulk kernels. The generated sequence
+        // differs from the one generated by repeated operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            generate(first, last, random, param_.n(), chi_squared_);
+        }
+
+        // generate fills the range [first, last) with t random numbers with
+        // given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            ziggurat_detail::chi_squared_sampler<T> chi_squared{param.n()};
+            generate(first, last, random, param.n(), chi_squared);
+        }
+
+        // n returns the degrees of freedom of this distribution.
+        result_type n() const
+        {
+            return param_.n();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+            chi_squared_ = ziggurat_detail::chi_squared_sampler<T>{param.n()};
+        }
+
+        // min returns -infinity.
+        result_type min() const
+        {
+            return -std::numeric_limits<result_type>::infinity();
+        }
+
+        // max returns +infinity.
+        result_type max() const
+        {
+            return std::numeric_limits<result_type>::infinity();
+        }
+
+    private:
+        template<typename URNG>
+        inline T sample(URNG& random, T n, ziggurat_detail::chi_squared_sampler<T>& chi_squared)
+        {
+            auto const z = normal_(random);
+            return z * std::sqrt(n / chi_squared(random));
+        }
+
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            T n,
+            ziggurat_detail::chi_squared_sampler<T>& chi_squared
+        )
+        {
+            constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+            T normals[block_size];
+            T chi_squares[block_size];
+
+            auto remaining = std::size_t(std::distance(first, last));
+
+            while (remaining > 0) {
+                auto const count = std::min(remaining, block_size);
+
+                normal_.generate(normals, normals + count, random);
+                chi_squared.generate(chi_squares, chi_squares + count, random);
+
+                for (std::size_t i = 0; i < count; i++) {
+                    *first = normals[i] * std::sqrt(n / chi_squares[i]);
+                    ++first;
+                }
+
+                remaining -= count;
+            }
+        }
+
+        param_type param_;
+        ziggurat_detail::chi_squared_sampler<T> chi_squared_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename T>
+    bool operator==(
+        ziggurat_student_t_distribution<T> const& d1,
+        ziggurat_student_t_distribution<T> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    template<typename T>
+    bool operator!=(
+        ziggurat_student_t_distribution<T> const& d1,
+        ziggurat_student_t_distribution<T> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output operator writes the n parameter to a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_student_t_distribution<T> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input operator reads the n parameter from a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_student_t_distribution<T>& dist
+    )
+    {
+        typename ziggurat_student_t_distribution<T>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+
+    // ziggurat_beta_distribution generates beta random numbers as
+    // X / (X + Y) where X and Y are gamma random numbers with shapes alpha
+    // and beta generated by the method of Marsaglia and Tsang. If a shape is
+    // less than one, the boost factors of X and Y are kept as logarithms so
+    // that tiny shapes give 0 or 1 rather than NaN. The standard library has
+    // no beta distribution; the interface follows the other standard
+    // distributions.
+    template<typename T>
+    class ziggurat_beta_distribution
+    {
+    public:
+        // result_type is an alias of T.
+        using result_type = T;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_beta_distribution;
+
+            // Default constructor initializes alpha and beta to 1.
+            param_type() = default;
+
+            // This constructor initializes the shapes alpha and beta to given
+            // values.
+            explicit param_type(result_type alpha, result_type beta = 1)
+                : alpha_{alpha}, beta_{beta}
+            {
+            }
+
+            // alpha returns the first shape parameter.
+            inline result_type alpha() const
+            {
+                return alpha_;
+            }
+
+            // beta returns the second shape parameter.
+            inline result_type beta() const
+            {
+                return beta_;
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.alpha_ == p2.alpha_ && p1.beta_ == p2.beta_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes alpha and beta to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    Char const space = os.widen(' ');
+                    os << param.alpha_ << space << param.beta_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads alpha and beta from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.alpha_ >> tmp.beta_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            result_type alpha_ = 1;
+            result_type beta_ = 1;
+        };
+
+        // Default constructor creates a beta distribution with alpha = 1 and
+        // beta = 1, which is the uniform distribution on [0, 1].
+        ziggurat_beta_distribution()
+            : ziggurat_beta_distribution{param_type{}}
+        {
+        }
+
+        // This constructor creates a beta distribution with given shapes.
+        explicit ziggurat_beta_distribution(result_type alpha, result_type beta = 1)
+            : ziggurat_beta_distribution{param_type{alpha, beta}}
+        {
+        }
+
+        // This constructor creates a beta distribution having given
+        // parameters.
+        explicit ziggurat_beta_distribution(param_type const& param)
+            : param_{param}, x_{param.alpha()}, y_{param.beta()}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated beta random number with the preconfigured parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random)
+        {
+            if (in_log_space()) {
+                T log_boost_x;
+                T log_boost_y;
+                auto const x = x_.split_sample(random, log_boost_x);
+                auto const y = y_.split_sample(random, log_boost_y);
+                return from_split(x, y, log_boost_x, log_boost_y);
+            }
+            auto const x = x_(random);
+            auto const y = y_(random);
+            return x / (x + y);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated beta random number with given
+        // parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random, param_type const& param)
+        {
+            if (param == param_) {
+                return (*this)(random);
+            }
+            ziggurat_beta_distribution dist{param};
+            return dist(random);
+        }
+
+        // generate fills the range [first, last) with beta random numbers
+        // with the preconfigured parameters. Blocks of X and Y are generated
+        // by the bulk gamma kernel. The generated sequence differs from the
+        // one generated by repeated operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+            T xs[block_size];
+            T ys[block_size];
+            T log_boost_xs[block_size];
+            T log_boost_ys[block_size];
+
+            auto remaining = std::size_t(std::distance(first, last));
+
+            while (remaining > 0) {
+                auto const count = std::min(remaining, block_size);
+
+                if (in_log_space()) {
+                    x_.generate_split(xs, log_boost_xs, count, random);
+                    y_.generate_split(ys, log_boost_ys, count, random);
+
+                    for (std::size_t i = 0; i < count; i++) {
+                        xs[i] = from_split(xs[i], ys[i], log_boost_xs[i], log_boost_ys[i]);
+                    }
+                } else {
+                    x_.generate(xs, xs + count, random, 1);
+                    y_.generate(ys, ys + count, random, 1);
+
+                    for (std::size_t i = 0; i < count; i++) {
+                        xs[i] = xs[i] / (xs[i] + ys[i]);
+                    }
+                }
+
+                first = std::copy(xs, xs + count, first);
+
+                remaining -= count;
+            }
+        }
+
+        // generate fills the range [first, last) with beta random numbers
+        // with given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            ziggurat_beta_distribution dist{param};
+            dist.generate(first, last, random);
+        }
+
+        // alpha returns the first shape parameter of this distribution.
+        result_type alpha() const
+        {
+            return param_.alpha();
+        }
+
+        // beta returns the second shape parameter of this distribution.
+        result_type beta() const
+        {
+            return param_.beta();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+            x_ = ziggurat_detail::marsaglia_tsang<T>{param.alpha()};
+            y_ = ziggurat_detail::marsaglia_tsang<T>{param.beta()};
+        }
+
+        // min returns 0.
+        result_type min() const
+        {
+            return 0;
+        }
+
+        // max returns 1.
+        result_type max() const
+        {
+            return 1;
+        }
+
+    private:
+        // in_log_space returns true if a shape is less than one. Then X and Y
+        // underflow to zero often enough that X / (X + Y) would be NaN, so
+        // their boost factors are kept as logarithms.
+        bool in_log_space() const
+        {
+            return x_.boosted() || y_.boosted();
+        }
+
+        // from_split returns X / (X + Y) for X = x exp(log_boost_x) and
+        // Y = y exp(log_boost_y), where x and y are positive gamma numbers
+        // without the boost. The ratio of the boosts is computed in log
+        // space, so the result is in [0, 1] even if X and Y underflow.
+        static T from_split(T x, T y, T log_boost_x, T log_boost_y)
+        {
+            return x / (x + y * std::exp(log_boost_y - log_boost_x));
+        }
+
+        param_type param_;
+        ziggurat_detail::marsaglia_tsang<T> x_;
+        ziggurat_detail::marsaglia_tsang<T> y_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename T>
+    bool operator==(
+        ziggurat_beta_distribution<T> const& d1,
+        ziggurat_beta_distribution<T> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    template<typename T>
+    bool operator!=(
+        ziggurat_beta_distribution<T> const& d1,
+        ziggurat_beta_distribution<T> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output operator writes alpha and beta parameters to a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_beta_distribution<T> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input operator reads alpha and beta parameters from a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_beta_distribution<T>& dist
+    )
+    {
+        typename ziggurat_beta_distribution<T>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+}
+
+#undef ZIGGURAT_LIKELY
+#undef ZIGGURAT_NOINLINE
+
+#endif
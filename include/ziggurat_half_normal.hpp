@@ -0,0 +1,490 @@
+// Half-normal distribution using a 256-layer ziggurat
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_HALF_NORMAL_HPP
+#define INCLUDED_ZIGGURAT_HALF_NORMAL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <random>
+
+#include "ziggurat.hpp"
+
+#if defined(__GNUC__)
+# define ZIGGURAT_LIKELY(x) __builtin_expect((x), 1)
+# define ZIGGURAT_NOINLINE __attribute__((noinline))
+#else
+# define ZIGGURAT_LIKELY(x) (x)
+# define ZIGGURAT_NOINLINE
+#endif
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // half_normal_ziggurat holds a pre-computed 256-layer ziggurat table
+        // of the half-normal distribution. It is generated by the same
+        // program as normal_ziggurat with 8 table bits.
+        template<typename T>
+        struct half_normal_ziggurat
+        {
+            static T const edges[0x101];
+        };
+    }
+
+    // ziggurat_half_normal_distribution generates half-normal random numbers
+    // sigma |Z| where Z is a standard normal number. The sign bit that the
+    // normal distribution draws is spent on the layer index instead, so the
+    // ziggurat has 256 layers and the fast path is taken more often than in
+    // the normal distribution for the same amount of entropy.
+    template<typename T>
+    class ziggurat_half_normal_distribution
+    {
+        // Pull in the ziggurat table to use.
+        using ziggurat = ziggurat_detail::half_normal_ziggurat<T>;
+
+    public:
+        // result_type is an alias of T.
+        using result_type = T;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_half_normal_distribution;
+
+            // Default constructor initializes sigma to 1.
+            param_type() = default;
+
+            // This constructor initializes the scale sigma to given value.
+            explicit param_type(result_type sigma)
+                : sigma_{sigma}
+            {
+            }
+
+            // sigma returns the standard deviation of the underlying normal
+            // distribution.
+            inline result_type sigma() const
+            {
+                return sigma_;
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.sigma_ == p2.sigma_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes sigma to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    os << param.sigma_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads sigma from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.sigma_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            result_type sigma_ = 1;
+        };
+
+        // Default constructor creates a half-normal distribution with
+        // sigma = 1.
+        ziggurat_half_normal_distribution() = default;
+
+        // This constructor creates a half-normal distribution with given
+        // sigma.
+        explicit ziggurat_half_normal_distribution(result_type sigma)
+            : param_{sigma}
+        {
+        }
+
+        // This constructor creates a half-normal distribution having given
+        // parameters.
+        explicit ziggurat_half_normal_distribution(param_type const& param)
+            : param_{param}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated half-normal random number with the preconfigured
+        // parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random)
+        {
+            return param_.sigma() * sample(random);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated half-normal random number with
+        // given parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random, param_type const& param)
+        {
+            return param.sigma() * sample(random);
+        }
+
+        // generate fills the range [first, last) with half-normal random
+        // numbers with the preconfigured parameters. Like the bulk kernel of
+        // ziggurat_normal_distribution, the generated sequence differs from
+        // the one generated by repeated operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            generate(first, last, random, param_);
+        }
+
+        // generate fills the range [first, last) with half-normal random
+        // numbers with given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            constexpr std::size_t bit_count = ziggurat_detail::engine_bits<URNG>();
+            constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+            std::uint64_t bits[block_size];
+            T samples[block_size];
+            bool accepts[block_size];
+
+            auto remaining = std::size_t(std::distance(first, last));
+
+            while (remaining > 0) {
+                auto const count = std::min(remaining, block_size);
+
+                for (std::size_t i = 0; i < count; i++) {
+                    bits[i] = ziggurat_detail::generate_bits<bit_count>(random);
+                }
+
+                // The fast path is branch-free so that the compiler can
+                // vectorize this loop.
+                for (std::size_t i = 0; i < count; i++) {
+                    auto const uniform = ziggurat_detail::canonicalize<bit_count, T>(bits[i]);
+                    auto const layer = std::size_t(bits[i] & 0xFF);
+                    auto const x = uniform * ziggurat::edges[layer];
+
+                    samples[i] = x;
+                    accepts[i] = x < ziggurat::edges[layer + 1];
+                }
+
+                for (std::size_t i = 0; i < count; i++) {
+                    auto const z = ZIGGURAT_LIKELY(accepts[i])
+                        ? samples[i] : finish_sample<bit_count>(random, bits[i]);
+                    *first = param.sigma() * z;
+                    ++first;
+                }
+
+                remaining -= count;
+            }
+        }
+
+        // sigma returns the sigma parameter of this distribution.
+        result_type sigma() const
+        {
+            return param_.sigma();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+        }
+
+        // min returns 0.
+        result_type min() const
+        {
+            return 0;
+        }
+
+        // max returns +infinity.
+        result_type max() const
+        {
+            return std::numeric_limits<result_type>::infinity();
+        }
+
+    private:
+        // sample generates a standard half-normal number.
+        template<typename URNG>
+        inline T sample(URNG& random) const
+        {
+            constexpr std::size_t bit_count = ziggurat_detail::engine_bits<URNG>();
+
+            for (;;)
+            {
+                auto const bits = ziggurat_detail::generate_bits<bit_count>(random);
+                auto const uniform = ziggurat_detail::canonicalize<bit_count, T>(bits);
+                auto const layer = std::size_t(bits & 0xFF);
+
+                auto const lower_edge = ziggurat::edges[layer];
+                auto const upper_edge = ziggurat::edges[layer + 1];
+
+                auto const x = uniform * lower_edge;
+
+                if (ZIGGURAT_LIKELY(x < upper_edge)) {
+                    return x;
+                }
+
+                if (layer == 0) {
+                    return sample_from_tail(random);
+                }
+
+                if (check_accept(random, lower_edge, upper_edge, x)) {
+                    return x;
+                }
+            }
+        }
+
+        // finish_sample continues a sampling step whose fast-path test failed
+        // in the bulk generation kernel.
+        template<std::size_t N, typename URNG>
+        ZIGGURAT_NOINLINE
+        T finish_sample(URNG& random, std::uint64_t bits) const
+        {
+            auto const uniform = ziggurat_detail::canonicalize<N, T>(bits);
+            auto const layer = std::size_t(bits & 0xFF);
+
+            auto const lower_edge = ziggurat::edges[layer];
+            auto const upper_edge = ziggurat::edges[layer + 1];
+
+            auto const x = uniform * lower_edge;
+
+            if (layer == 0) {
+                return sample_from_tail(random);
+            }
+
+            if (check_accept(random, lower_edge, upper_edge, x)) {
+                return x;
+            }
+
+            return sample(random);
+        }
+
+        template<typename URNG>
+        ZIGGURAT_NOINLINE
+        T sample_from_tail(URNG& random) const
+        {
+            T const tail_edge = ziggurat::edges[1];
+
+            std::uniform_real_distribution<T> uniform;
+
+            T x, y;
+            do {
+                x = -std::log(uniform(random)) / tail_edge;
+                y = -std::log(uniform(random));
+            } while (2 * y < x * x);
+
+            return tail_edge + x;
+        }
+
+        template<typename URNG>
+        ZIGGURAT_NOINLINE
+        bool check_accept(URNG& random, T lower_edge, T upper_edge, T x) const
+        {
+            // Rejection sampling from the interval [upper_edge, lower_edge].
+            std::uniform_real_distribution<T> uniform(
+                ziggurat_detail::gaussian(lower_edge),
+                ziggurat_detail::gaussian(upper_edge)
+            );
+            return uniform(random) < ziggurat_detail::gaussian(x);
+        }
+
+    private:
+        param_type param_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename T>
+    bool operator==(
+        ziggurat_half_normal_distribution<T> const& d1,
+        ziggurat_half_normal_distribution<T> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    // Inequality comparison d1 != d2 compares the inequality of distribution
+    // parameters.
+    template<typename T>
+    bool operator!=(
+        ziggurat_half_normal_distribution<T> const& d1,
+        ziggurat_half_normal_distribution<T> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output operator writes the sigma parameter to a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_half_normal_distribution<T> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input operator reads the sigma parameter from a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_half_normal_distribution<T>& dist
+    )
+    {
+        typename ziggurat_half_normal_distribution<T>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+
+    // Pre-computed ziggurat table.
+    template<typename T>
+    T const ziggurat_detail::half_normal_ziggurat<T>::edges[] = {
+        T(3.91075795952491578), T(3.6541528853610088), T(3.4492782985614312), T(3.32024473383982555),
+        T(3.22457505204780137), T(3.1478892895180004), T(3.08352613200214298), T(3.02783779176959378),
+        T(2.97860327988184315), T(2.93436686720888762), T(2.8941210536134121), T(2.85713873087322456),
+        T(2.8228773968264429), T(2.79092117400192707), T(2.76094400527998607), T(2.73268535904401144),
+        T(2.70593365612306203), T(2.68051464328574518), T(2.65628303757674322), T(2.63311639363158267),
+        T(2.6109105184888235), T(2.58957598670828659), T(2.56903545268184397), T(2.54922155032478326),
+        T(2.53007523215985408), T(2.5115444416266941), T(2.49358304127104669), T(2.4761499396705231),
+        T(2.45920837433470485), T(2.44272531820036409), T(2.42667098493714661), T(2.41101841390111948),
+        T(2.39574311978192744), T(2.38082279517208573), T(2.36623705671729079), T(2.35196722737914454),
+        T(2.3379961487965284), T(2.32430801887113248), T(2.31088825060137149), T(2.29772334890286345),
+        T(2.28480080272449193), T(2.27210899022838175), T(2.25963709517378764), T(2.24737503294738916),
+        T(2.23531338492992093), T(2.22344334009251021), T(2.21175664288416085), T(2.20024554661127603),
+        T(2.18890277162636071), T(2.17772146774029274), T(2.16669518035430819), T(2.15581781987673748),
+        T(2.14508363404788893), T(2.13448718284601657), T(2.12402331568952363), T(2.11368715068665303),
+        T(2.103474055714877), T(2.09337963113879155), T(2.08339969399830416), T(2.0735302635187427),
+        T(2.06376754781173188), T(2.05410793165065186), T(2.04454796521753135), T(2.03508435372961882),
+        T(2.02571394786385417), T(2.01643373490620403), T(2.00724083056052871), T(1.99813247135841943),
+        T(1.98910600761743805), T(1.98015889690047642), T(1.97128869793365902), T(1.96249306494436282),
+        T(1.95376974238464651), T(1.94511656000867816), T(1.93653142827569447), T(1.92801233405266559),
+        T(1.91955733659318795), T(1.9111645637712531), T(1.90283220855042901), T(1.89455852567070449),
+        T(1.88634182853678256), T(1.87818048629299561), T(1.87007292107126655), T(1.86201760539967398),
+        T(1.85401305976020181), T(1.84605785028518521), T(1.83815058658280628), T(1.83028991968275667),
+        T(1.82247454009388554), T(1.81470317596628239), T(1.80697459135082061), T(1.79928758454972004),
+        T(1.79164098655216231), T(1.78403365954944126), T(1.77646449552452257), T(1.7689324149112684),
+        T(1.76143636531891001), T(1.75397532031767112), T(1.7465482782817221), T(1.73915426128591144),
+        T(1.73179231405296297), T(1.72446150294804479), T(1.71716091501782286), T(1.70988965707130158),
+        T(1.70264685479992295), T(1.69543165193456136), T(1.6882432094371953), T(1.68108070472517368),
+        T(1.67394333092612491), T(1.66683029616166545), T(1.65974082285818247), T(1.65267414708305593),
+        T(1.64562951790478218), T(1.63860619677554764), T(1.63160345693487319), T(1.62462058283303468),
+        T(1.61765686957301535), T(1.6107116223698299), T(1.60378415602609437), T(1.59687379442278798),
+        T(1.58997987002419072), T(1.58310172339602917), T(1.57623870273590616), T(1.5693901634151235),
+        T(1.56255546753104468), T(1.55573398346917613), T(1.54892508547417318), T(1.54212815322900165),
+        T(1.53534257144151387), T(1.52856772943771224), T(1.52180302076099783), T(1.51504784277671445),
+        T(1.50830159628131133), T(1.50156368511546368), T(1.49483351578049328), T(1.48811049705744725),
+        T(1.48139403962818705), T(1.47468355569785525), T(1.4679784586180793), T(1.46127816251027531),
+        T(1.45458208188840987), T(1.4478896312805758), T(1.44120022484872345), T(1.43451327600589185),
+        T(1.42782819703025554), T(1.42114439867530851), T(1.41446128977547092), T(1.40777827684639845),
+        T(1.40109476367925057), T(1.3944101509281408), T(1.3877238356899757), T(1.38103521107585503),
+        T(1.37434366577316602), T(1.36764858359747588), T(1.36094934303328263), T(1.35424531676263471),
+        T(1.34753587118058671), T(1.34082036589640374), T(1.33409815321935965), T(1.32736857762792559),
+        T(1.3206309752210561), T(1.31388467315022028), T(1.30712898903073094), T(1.30036323033083701),
+        T(1.29358669373694779), T(1.28679866449324343), T(1.27999841571381801), T(1.27318520766535626),
+        T(1.2663582870182295), T(1.25951688606371426), T(1.25266022189489723), T(1.24578749554862722),
+        T(1.23889789110568738), T(1.23199057474613594), T(1.22506469375653082), T(1.21811937548548155),
+        T(1.2111537262436991), T(1.20416683014438153), T(1.19715774787944151), T(1.19012551542669209),
+        T(1.1830691426826867), T(1.17598761201545199), T(1.16887987673083305), T(1.16174485944561146),
+        T(1.15458145035992743), T(1.14738850542084903), T(1.14016484436815113), T(1.13290924865253362),
+        T(1.12562045921553344), T(1.11829717411934504), T(1.11093804601357582), T(1.10354167942463977),
+        T(1.09610662785202129), T(1.08863139065397951), T(1.08111440970340378), T(1.07355406579243606),
+        T(1.06594867476212229), T(1.05829648333067494), T(1.05059566459092979), T(1.04284431314414872),
+        T(1.03504043983344052), T(1.0271819660356456), T(1.01926671746548414), T(1.01129241743999554),
+        T(1.0032566795446729), T(0.995156999635090744), T(0.986990747099062316), T(0.97875515529422441),
+        T(0.970447311064224216), T(0.962064143223040458), T(0.953602409881085911), T(0.945058684468165322),
+        T(0.936429340286574985), T(0.927710533401999826), T(0.918898183649590305), T(0.909987953496718238),
+        T(0.900975224461221691), T(0.891855070732941457), T(0.882622229585165563), T(0.87327106808886068),
+        T(0.863795545553308841), T(0.854189171008163828), T(0.844444954909154055), T(0.834555354086382262),
+        T(0.824512208752292253), T(0.814306670135215516), T(0.803929116989971493), T(0.793369058840623476),
+        T(0.782615023307233204), T(0.771654424224568092), T(0.760473406430108079), T(0.7490566620178154),
+        T(0.737387211434295531), T(0.725446140909999593), T(0.713212285190976014), T(0.700661841106815064),
+        T(0.687767892795788427), T(0.674499822837293816), T(0.660822574244419814), T(0.646695714894993667),
+        T(0.632072236386061026), T(0.616896990007751334), T(0.601104617755992443), T(0.58461676610637936),
+        T(0.567338257053818684), T(0.549151702327165037), T(0.529909720661557948), T(0.509423329602091801),
+        T(0.487443966139236018), T(0.463634336790882173), T(0.437518402207871859), T(0.408389134611991278),
+        T(0.375121332878380787), T(0.335737519214425573), T(0.286174591792072719), T(0.21524189598488247),
+        T(2.10734242554470173e-08)
+    };
+}
+
+#undef ZIGGURAT_LIKELY
+#undef ZIGGURAT_NOINLINE
+
+#endif
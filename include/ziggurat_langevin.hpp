@@ -0,0 +1,157 @@
+// Fused Langevin thermostat noise for molecular dynamics integrators
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_LANGEVIN_HPP
+#define INCLUDED_ZIGGURAT_LANGEVIN_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#include "ziggurat.hpp"
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // langevin_update sets v[i] = c1 v[i] + scale[i] noise[i] for a
+        // block of numbers. The trip count is fixed and scale and noise are
+        // local buffers of the caller, so the loop vectorizes at -O2.
+        template<typename T>
+        void langevin_update(T* v, T const* scale, T const* noise, T c1)
+        {
+            for (std::size_t i = 0; i < bulk_block_size; i++) {
+                v[i] = c1 * v[i] + scale[i] * noise[i];
+            }
+        }
+    }
+
+    // apply_langevin_noise performs the friction and noise part of a
+    // Langevin integrator on the count velocity components at velocity in
+    // place:
+    //
+    //   v[i] = c1 v[i] + c2 scale[i] Z[i],
+    //
+    // where the Z[i] are standard normal numbers and scale[i] is typically
+    // sqrt(kT / m) of the particle owning the component. For the O step of
+    // BAOAB with friction gamma and step dt, c1 = exp(-gamma dt) and
+    // c2 = sqrt(1 - c1^2), which is best computed as
+    // sqrt(-expm1(-2 gamma dt)). For Euler-Maruyama, c1 = 1 - gamma dt and
+    // c2 = sqrt(2 gamma dt).
+    //
+    // The normal numbers are generated for a block of
+    // ziggurat_detail::bulk_block_size components into a stack buffer and
+    // applied while the buffer is in the L1 cache, so no noise array of the
+    // size of the system is written and read back. Each full block draws its
+    // own numbers, so splitting the array into calls at multiples of the
+    // block size does not change the sequence.
+    template<typename T, typename URNG>
+    void apply_langevin_noise(
+        T* velocity,
+        T const* scale,
+        std::size_t count,
+        T c1,
+        T c2,
+        URNG& random
+    )
+    {
+        constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+        ziggurat_normal_distribution<T> normal;
+        T noise[block_size];
+        T block_scale[block_size];
+        std::size_t i = 0;
+
+        for (; i + block_size <= count; i += block_size) {
+            normal.generate(noise, noise + block_size, random);
+            for (std::size_t k = 0; k < block_size; k++) {
+                block_scale[k] = c2 * scale[i + k];
+            }
+            ziggurat_detail::langevin_update(velocity + i, block_scale, noise, c1);
+        }
+
+        if (i < count) {
+            auto const tail = count - i;
+            normal.generate(noise, noise + tail, random);
+            for (std::size_t k = 0; k < tail; k++) {
+                velocity[i + k] = c1 * velocity[i + k] + c2 * scale[i + k] * noise[k];
+            }
+        }
+    }
+
+    // apply_langevin_noise3 is apply_langevin_noise for three-dimensional
+    // velocities stored as an array of count (x, y, z) triples. The three
+    // components of the particle p share the scale factor scale[p]. Calls
+    // may be split as for apply_langevin_noise, counting particles instead
+    // of components.
+    template<typename T, typename URNG>
+    void apply_langevin_noise3(
+        T* velocity,
+        T const* scale,
+        std::size_t count,
+        T c1,
+        T c2,
+        URNG& random
+    )
+    {
+        constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+        constexpr std::size_t dimension = 3;
+
+        ziggurat_normal_distribution<T> normal;
+        T noise[block_size];
+        T block_scale[dimension * block_size];
+
+        // The scale factors of a block of particles are spread to their
+        // components once, and the three blocks of components are then
+        // updated as in the flat case.
+        for (std::size_t p = 0; p < count; p += block_size) {
+            auto const particles = std::min(block_size, count - p);
+            for (std::size_t k = 0; k < particles; k++) {
+                auto const s = c2 * scale[p + k];
+                block_scale[dimension * k] = s;
+                block_scale[dimension * k + 1] = s;
+                block_scale[dimension * k + 2] = s;
+            }
+            auto const v = velocity + dimension * p;
+            auto const components = dimension * particles;
+            for (std::size_t j = 0; j < components; j += block_size) {
+                if (j + block_size <= components) {
+                    normal.generate(noise, noise + block_size, random);
+                    ziggurat_detail::langevin_update(v + j, block_scale + j, noise, c1);
+                } else {
+                    auto const tail = components - j;
+                    normal.generate(noise, noise + tail, random);
+                    for (std::size_t k = 0; k < tail; k++) {
+                        v[j + k] = c1 * v[j + k] + block_scale[j + k] * noise[k];
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,461 @@
+// Lognormal random number generation built on the ziggurat normal distribution
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_LOGNORMAL_HPP
+#define INCLUDED_ZIGGURAT_LOGNORMAL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+
+#include "ziggurat.hpp"
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // exp_traits holds the constants of exp_block for a floating-point
+        // type: the integer type of the same size, the argument range beyond
+        // which exp overflows to infinity or underflows to zero, the
+        // rounding offset that makes x / log(2) + 1/2 positive, the
+        // Cody-Waite split of log(2) and the Taylor polynomial of exp(r) for
+        // |r| <= log(2) / 2.
+        template<typename T>
+        struct exp_traits;
+
+        template<>
+        struct exp_traits<double>
+        {
+            using bits_type = std::uint64_t;
+
+            static constexpr int mantissa_bits = 52;
+            static constexpr std::int32_t exponent_bias = 1023;
+            static constexpr double min_arg = -746;
+            static constexpr double max_arg = 710;
+            static constexpr double rounding_offset = 2048.5;
+            static constexpr double log2e = 1.4426950408889634;
+            static constexpr double ln2_hi = 0.693147180369123816490;
+            static constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+            static inline double polynomial(double r)
+            {
+                double p = 1.0 / 6227020800;
+                p = p * r + 1.0 / 479001600;
+                p = p * r + 1.0 / 39916800;
+                p = p * r + 1.0 / 3628800;
+                p = p * r + 1.0 / 362880;
+                p = p * r + 1.0 / 40320;
+                p = p * r + 1.0 / 5040;
+                p = p * r + 1.0 / 720;
+                p = p * r + 1.0 / 120;
+                p = p * r + 1.0 / 24;
+                p = p * r + 1.0 / 6;
+                p = p * r + 1.0 / 2;
+                p = p * r + 1;
+                return p * r + 1;
+            }
+        };
+
+        template<>
+        struct exp_traits<float>
+        {
+            using bits_type = std::uint32_t;
+
+            static constexpr int mantissa_bits = 23;
+            static constexpr std::int32_t exponent_bias = 127;
+            static constexpr float min_arg = -104;
+            static constexpr float max_arg = 89;
+            static constexpr float rounding_offset = 256.5F;
+            static constexpr float log2e = 1.44269504F;
+            static constexpr float ln2_hi = 0.693145751953125F;
+            static constexpr float ln2_lo = 1.428606765330187045e-06F;
+
+            static inline float polynomial(float r)
+            {
+                float p = 1.0F / 5040;
+                p = p * r + 1.0F / 720;
+                p = p * r + 1.0F / 120;
+                p = p * r + 1.0F / 24;
+                p = p * r + 1.0F / 6;
+                p = p * r + 1.0F / 2;
+                p = p * r + 1;
+                return p * r + 1;
+            }
+        };
+
+        // exp_kernel replaces each of the bulk_block_size numbers at data by
+        // its exponential. The loops are branch-free, use no library calls
+        // and have a fixed trip count, so the compiler vectorizes them even
+        // at -O2. The result is accurate to one ulp, including subnormal
+        // results, and is infinity above max_arg, zero below min_arg and NaN
+        // for NaN as with std::exp.
+        template<typename T>
+        void exp_kernel(T* data)
+        {
+            using traits = exp_traits<T>;
+            using bits_type = typename traits::bits_type;
+
+            constexpr std::size_t size = bulk_block_size;
+            T const min_arg = traits::min_arg;
+            T const max_arg = traits::max_arg;
+            T const infinity = std::numeric_limits<T>::infinity();
+
+            // Clamping or selecting the out-of-range results in the main
+            // loop would make GCC duplicate the loop body for those values,
+            // which blocks vectorization, so they are separate loops. The
+            // clamp keeps the integer conversion in range; NaN, which fails
+            // every comparison, is replaced by zero for the conversion.
+            T values[size];
+            for (std::size_t i = 0; i < size; i++) {
+                auto const x = data[i];
+                auto const clamped = x < min_arg ? min_arg : (x > max_arg ? max_arg : x);
+                values[i] = x == x ? clamped : T(0);
+            }
+
+            for (std::size_t i = 0; i < size; i++) {
+                auto const x = values[i];
+
+                // Round x / log(2) to the nearest integer k. Truncating a
+                // positive number is floor, and unlike the shifter trick the
+                // conversion is not folded away by -ffast-math.
+                auto const biased = static_cast<std::int32_t>(
+                    x * traits::log2e + traits::rounding_offset
+                );
+                auto const k = biased - static_cast<std::int32_t>(traits::rounding_offset);
+                auto const kf = static_cast<T>(k);
+                auto const r = (x - kf * traits::ln2_hi) - kf * traits::ln2_lo;
+                auto const p = traits::polynomial(r);
+
+                // Build 2^k as 2^k1 2^k2 in the exponent fields. Either
+                // factor is a normal number for any k in the argument range,
+                // and the product rounds once into the subnormal range or
+                // overflows to infinity.
+                auto const k1 = k / 2;
+                auto const k2 = k - k1;
+                bits_type const scale1_bits =
+                    static_cast<bits_type>(k1 + traits::exponent_bias) << traits::mantissa_bits;
+                bits_type const scale2_bits =
+                    static_cast<bits_type>(k2 + traits::exponent_bias) << traits::mantissa_bits;
+                T scale1;
+                T scale2;
+                std::memcpy(&scale1, &scale1_bits, sizeof scale1);
+                std::memcpy(&scale2, &scale2_bits, sizeof scale2);
+
+                values[i] = p * scale1 * scale2;
+            }
+
+            for (std::size_t i = 0; i < size; i++) {
+                auto const x = data[i];
+                auto const result = x > max_arg ? infinity : (x < min_arg ? T(0) : values[i]);
+                data[i] = x == x ? result : x;
+            }
+        }
+
+        // exp_block replaces each of data[0], ..., data[size - 1] by its
+        // exponential using exp_kernel.
+        template<typename T>
+        void exp_block(T* data, std::size_t size)
+        {
+            std::size_t i = 0;
+
+            for (; i + bulk_block_size <= size; i += bulk_block_size) {
+                exp_kernel(data + i);
+            }
+
+            if (i < size) {
+                T tail[bulk_block_size] = {};
+                std::copy(data + i, data + size, tail);
+                exp_kernel(tail);
+                std::copy(tail, tail + (size - i), data + i);
+            }
+        }
+    }
+
+    // ziggurat_lognormal_distribution generates lognormal random numbers
+    // exp(m + s Z) where Z is a ziggurat normal number. It is a drop-in
+    // replacement for std::lognormal_distribution.
+    template<typename T>
+    class ziggurat_lognormal_distribution
+    {
+    public:
+        // result_type is an alias of T.
+        using result_type = T;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_lognormal_distribution;
+
+            // Default constructor initializes m to 0 and s to 1.
+            param_type() = default;
+
+            // This constructor initializes the log-scale mean m and the
+            // log-scale standard deviation s to given values.
+            explicit param_type(result_type m, result_type s = 1)
+                : m_{m}, s_{s}
+            {
+            }
+
+            // m returns the mean of the logarithm.
+            inline result_type m() const
+            {
+                return m_;
+            }
+
+            // s returns the standard deviation of the logarithm.
+            inline result_type s() const
+            {
+                return s_;
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.m_ == p2.m_ && p1.s_ == p2.s_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes m and s to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    Char const space = os.widen(' ');
+                    os << param.m_ << space << param.s_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads m and s from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.m_ >> tmp.s_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            result_type m_ = 0;
+            result_type s_ = 1;
+        };
+
+        // Default constructor creates a lognormal distribution with m = 0 and
+        // s = 1.
+        ziggurat_lognormal_distribution() = default;
+
+        // This constructor creates a lognormal distribution with given m and
+        // s.
+        explicit ziggurat_lognormal_distribution(result_type m, result_type s = 1)
+            : param_{m, s}
+        {
+        }
+
+        // This constructor creates a lognormal distribution having given
+        // parameters.
+        explicit ziggurat_lognormal_distribution(param_type const& param)
+            : param_{param}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated lognormal random number with the preconfigured
+        // parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random)
+        {
+            return (*this)(random, param_);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated lognormal random number with given
+        // parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random, param_type const& param)
+        {
+            return std::exp(param.m() + param.s() * normal_(random));
+        }
+
+        // generate fills the range [first, last) with lognormal random
+        // numbers with the preconfigured parameters. Normal numbers come from
+        // the bulk ziggurat kernel and are exponentiated by a vectorized exp.
+        // The generated sequence differs from the one generated by repeated
+        // operator() calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            generate(first, last, random, param_);
+        }
+
+        // generate fills the range [first, last) with lognormal random
+        // numbers with given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            constexpr std::size_t block_size = ziggurat_detail::bulk_block_size;
+
+            typename ziggurat_normal_distribution<T>::param_type const normal_param{
+                param.m(), param.s()
+            };
+            T samples[block_size] = {};
+
+            auto remaining = std::size_t(std::distance(first, last));
+
+            while (remaining > 0) {
+                auto const count = std::min(remaining, block_size);
+
+                normal_.generate(samples, samples + count, random, normal_param);
+                ziggurat_detail::exp_kernel(samples);
+                first = std::copy(samples, samples + count, first);
+
+                remaining -= count;
+            }
+        }
+
+        // m returns the m parameter of this distribution.
+        result_type m() const
+        {
+            return param_.m();
+        }
+
+        // s returns the s parameter of this distribution.
+        result_type s() const
+        {
+            return param_.s();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+        }
+
+        // min returns 0.
+        result_type min() const
+        {
+            return 0;
+        }
+
+        // max returns +infinity.
+        result_type max() const
+        {
+            return std::numeric_limits<result_type>::infinity();
+        }
+
+    private:
+        param_type param_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename T>
+    bool operator==(
+        ziggurat_lognormal_distribution<T> const& d1,
+        ziggurat_lognormal_distribution<T> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    template<typename T>
+    bool operator!=(
+        ziggurat_lognormal_distribution<T> const& d1,
+        ziggurat_lognormal_distribution<T> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output operator writes m and s parameters to a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_lognormal_distribution<T> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input operator reads m and s parameters from a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_lognormal_distribution<T>& dist
+    )
+    {
+        typename ziggurat_lognormal_distribution<T>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+}
+
+#endif
@@ -0,0 +1,231 @@
+// Multivariate normal distribution with a reusable Cholesky factor
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_MULTIVARIATE_HPP
+#define INCLUDED_ZIGGURAT_MULTIVARIATE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "ziggurat.hpp"
+
+
+namespace cxx
+{
+    // multivariate_normal generates normal random vectors with given mean
+    // and covariance matrix. The covariance is factored into L L^T once on
+    // construction, and vectors are generated in blocks: a block of standard
+    // normal vectors is drawn by the bulk ziggurat kernel and transformed as
+    // the triangular matrix-matrix product L Z, which vectorizes across the
+    // vectors of the block. Generating a vector allocates nothing.
+    template<typename T>
+    class multivariate_normal
+    {
+    public:
+        // This constructor creates a multivariate normal distribution with
+        // given mean vector and covariance matrix. The covariance matrix is
+        // given in row-major order and must be symmetric positive-definite.
+        // Only its lower triangle is read. Throws std::invalid_argument if
+        // the sizes do not agree and std::domain_error if the matrix is not
+        // positive-definite.
+        multivariate_normal(std::vector<T> const& mean, std::vector<T> const& covariance)
+            : dimension_{mean.size()}
+            , mean_{mean}
+            , factor_(mean.size() * mean.size())
+            , normals_(mean.size() * block_vectors())
+        {
+            if (covariance.size() != dimension_ * dimension_) {
+                throw std::invalid_argument("covariance matrix size does not match mean");
+            }
+            factorize(covariance);
+        }
+
+        // dimension returns the dimension of generated vectors.
+        std::size_t dimension() const
+        {
+            return dimension_;
+        }
+
+        // mean returns the mean vector.
+        std::vector<T> const& mean() const
+        {
+            return mean_;
+        }
+
+        // cholesky_factor returns the lower triangular factor L of the
+        // covariance matrix in row-major order. The upper triangle is zero.
+        std::vector<T> const& cholesky_factor() const
+        {
+            return factor_;
+        }
+
+        // generate writes count random vectors to the array out, which must
+        // have room for count * dimension() numbers. Each vector is stored
+        // contiguously. The sequence does not depend on how a batch of
+        // vectors is split into calls as long as each call generates a
+        // multiple of block_vectors() vectors.
+        template<typename URNG>
+        void generate(T* out, std::size_t count, URNG& random)
+        {
+            auto const block = block_vectors();
+
+            for (std::size_t done = 0; done < count; done += block) {
+                auto const cols = std::min(block, count - done);
+                for (std::size_t j = 0; j < dimension_; j++) {
+                    auto const z_row = normals_.data() + j * block;
+                    normal_.generate(z_row, z_row + cols, random);
+                }
+                transform_block(out + done * dimension_, cols);
+            }
+        }
+
+        // block_vectors returns the number of vectors generated at once.
+        static constexpr std::size_t block_vectors()
+        {
+            return ziggurat_detail::bulk_block_size;
+        }
+
+    private:
+        // factorize computes the Cholesky factor of the covariance matrix.
+        void factorize(std::vector<T> const& covariance)
+        {
+            auto const n = dimension_;
+
+            for (std::size_t i = 0; i < n; i++) {
+                for (std::size_t j = 0; j <= i; j++) {
+                    auto sum = covariance[i * n + j];
+                    for (std::size_t k = 0; k < j; k++) {
+                        sum -= factor_[i * n + k] * factor_[j * n + k];
+                    }
+
+                    if (i == j) {
+                        if (!(sum > 0)) {
+                            throw std::domain_error("covariance matrix is not positive-definite");
+                        }
+                        factor_[i * n + i] = std::sqrt(sum);
+                    } else {
+                        factor_[i * n + j] = sum / factor_[j * n + j];
+                    }
+                }
+            }
+        }
+
+        // transform_block computes mean + L Z for the block of standard normal
+        // vectors Z and writes the first cols vectors to out. Z is stored in
+        // dimension-major order. Rows of the product are accumulated in local
+        // arrays, so the innermost loops run across a fixed number of vectors
+        // without aliasing and are vectorized even at -O2. Four rows are
+        // computed together to load each row of Z once for four rows of L.
+        // The columns of Z past cols hold stale numbers and are discarded.
+        void transform_block(T* out, std::size_t cols) const
+        {
+            constexpr std::size_t block = block_vectors();
+
+            auto const n = dimension_;
+            auto const z = normals_.data();
+            auto const l = factor_.data();
+
+            std::size_t i = 0;
+
+            for (; i + 4 <= n; i += 4) {
+                T rows[4][block];
+
+                for (std::size_t r = 0; r < 4; r++) {
+                    auto const mean = mean_[i + r];
+                    for (std::size_t k = 0; k < block; k++) {
+                        rows[r][k] = mean;
+                    }
+                }
+
+                for (std::size_t j = 0; j <= i; j++) {
+                    auto const l0 = l[(i + 0) * n + j];
+                    auto const l1 = l[(i + 1) * n + j];
+                    auto const l2 = l[(i + 2) * n + j];
+                    auto const l3 = l[(i + 3) * n + j];
+                    auto const z_row = z + j * block;
+
+                    for (std::size_t k = 0; k < block; k++) {
+                        auto const zk = z_row[k];
+                        rows[0][k] += l0 * zk;
+                        rows[1][k] += l1 * zk;
+                        rows[2][k] += l2 * zk;
+                        rows[3][k] += l3 * zk;
+                    }
+                }
+
+                // The lower triangle of the diagonal 4x4 block of L.
+                for (std::size_t j = i + 1; j < i + 4; j++) {
+                    auto const z_row = z + j * block;
+                    for (std::size_t r = j - i; r < 4; r++) {
+                        auto const lr = l[(i + r) * n + j];
+                        for (std::size_t k = 0; k < block; k++) {
+                            rows[r][k] += lr * z_row[k];
+                        }
+                    }
+                }
+
+                for (std::size_t k = 0; k < cols; k++) {
+                    for (std::size_t r = 0; r < 4; r++) {
+                        out[k * n + i + r] = rows[r][k];
+                    }
+                }
+            }
+
+            for (; i < n; i++) {
+                T row[block];
+
+                auto const mean = mean_[i];
+                for (std::size_t k = 0; k < block; k++) {
+                    row[k] = mean;
+                }
+
+                for (std::size_t j = 0; j <= i; j++) {
+                    auto const lj = l[i * n + j];
+                    auto const z_row = z + j * block;
+                    for (std::size_t k = 0; k < block; k++) {
+                        row[k] += lj * z_row[k];
+                    }
+                }
+
+                for (std::size_t k = 0; k < cols; k++) {
+                    out[k * n + i] = row[k];
+                }
+            }
+        }
+
+        std::size_t dimension_;
+        std::vector<T> mean_;
+        std::vector<T> factor_;
+        std::vector<T> normals_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+}
+
+#endif
@@ -0,0 +1,263 @@
+// Streaming NPY output of normal random numbers
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_NPY_HPP
+#define INCLUDED_ZIGGURAT_NPY_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ziggurat.hpp"
+#include "ziggurat_parallel.hpp"
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // npy_chunk_size is the number of numbers write_normal_npy generates
+        // and writes at once. It is a multiple of the parallel block size.
+        constexpr std::size_t npy_chunk_size = 64 * parallel_block_size;
+
+        // npy_header_alignment is the alignment of the data in an NPY file.
+        constexpr std::size_t npy_header_alignment = 64;
+
+        // is_little_endian returns true if the native byte order is little
+        // endian.
+        inline bool is_little_endian()
+        {
+            std::uint16_t const probe = 1;
+            unsigned char byte;
+            std::memcpy(&byte, &probe, 1);
+            return byte == 1;
+        }
+
+        // npy_descr returns the NPY type descriptor of T.
+        template<typename T>
+        std::string npy_descr()
+        {
+            static_assert(
+                std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                "T must be float32 or float64"
+            );
+            return std::string(is_little_endian() ? "<" : ">") + "f" + std::to_string(sizeof(T));
+        }
+
+        // make_npy_header returns the NPY header describing a C-order array
+        // of given type descriptor and shape. The format version is 1.0 if
+        // the header fits in the 16-bit length field and 2.0 otherwise.
+        inline std::string make_npy_header(
+            std::string const& descr,
+            std::vector<std::uint64_t> const& shape
+        )
+        {
+            std::string dict = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (";
+            for (std::size_t i = 0; i < shape.size(); i++) {
+                dict += std::to_string(shape[i]);
+                dict += (shape.size() == 1 || i + 1 < shape.size()) ? "," : "";
+                dict += (i + 1 < shape.size()) ? " " : "";
+            }
+            dict += "), }";
+
+            constexpr std::size_t v1_prefix_size = 10;
+            constexpr std::size_t v2_prefix_size = 12;
+
+            auto const padded_size = [&](std::size_t prefix_size) {
+                auto const size = prefix_size + dict.size() + 1;
+                return (size + npy_header_alignment - 1) / npy_header_alignment * npy_header_alignment;
+            };
+
+            bool const v1 = padded_size(v1_prefix_size) - v1_prefix_size <= 0xFFFF;
+            auto const prefix_size = v1 ? v1_prefix_size : v2_prefix_size;
+            auto const header_size = padded_size(prefix_size);
+            auto const header_len = header_size - prefix_size;
+
+            std::string header(1, char(0x93));
+            header += "NUMPY";
+            header += char(v1 ? 1 : 2);
+            header += char(0);
+            for (std::size_t i = 0; i < prefix_size - 8; i++) {
+                header += char((header_len >> (8 * i)) & 0xFF);
+            }
+            header += dict;
+            header.append(header_size - header.size() - 1, ' ');
+            header += '\n';
+
+            return header;
+        }
+    }
+
+    // npy_writer writes an array of float32 or float64 to an NPY file in a
+    // streaming fashion. The header is written on construction and the data
+    // is appended by write, so the whole array never needs to be in memory.
+    template<typename T>
+    class npy_writer
+    {
+    public:
+        // This constructor creates the NPY file at path for a C-order array
+        // of given shape. Throws std::system_error on I/O failure.
+        npy_writer(std::string const& path, std::vector<std::uint64_t> const& shape)
+            : path_{path}, file_{std::fopen(path.c_str(), "wb")}
+        {
+            if (!file_) {
+                throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+            }
+
+            expected_count_ = 1;
+            for (auto const dim : shape) {
+                expected_count_ *= dim;
+            }
+
+            auto const header = ziggurat_detail::make_npy_header(
+                ziggurat_detail::npy_descr<T>(), shape
+            );
+            write_bytes(header.data(), header.size());
+        }
+
+        npy_writer(npy_writer const&) = delete;
+        npy_writer& operator=(npy_writer const&) = delete;
+
+        ~npy_writer()
+        {
+            if (file_) {
+                std::fclose(file_);
+            }
+        }
+
+        // write appends count numbers to the array. Throws std::length_error
+        // if it would exceed the shape and std::system_error on I/O failure.
+        void write(T const* data, std::size_t count)
+        {
+            if (count > expected_count_ - written_count_) {
+                throw std::length_error("too many numbers written to " + path_);
+            }
+            write_bytes(data, count * sizeof(T));
+            written_count_ += count;
+        }
+
+        // close flushes and closes the file. Throws std::length_error if
+        // fewer numbers than the shape requires have been written and
+        // std::system_error on I/O failure.
+        void close()
+        {
+            if (written_count_ != expected_count_) {
+                throw std::length_error("too few numbers written to " + path_);
+            }
+            auto const file = file_;
+            file_ = nullptr;
+            if (std::fclose(file) != 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot write " + path_);
+            }
+        }
+
+    private:
+        void write_bytes(void const* data, std::size_t size)
+        {
+            if (std::fwrite(data, 1, size, file_) != size) {
+                throw std::system_error(errno, std::generic_category(), "cannot write " + path_);
+            }
+        }
+
+        std::string path_;
+        std::FILE* file_;
+        std::uint64_t expected_count_ = 0;
+        std::uint64_t written_count_ = 0;
+    };
+
+    // write_normal_npy writes an NPY file at path holding a C-order array of
+    // given shape filled with normal random numbers. The numbers are generated
+    // chunk by chunk with multiple threads while the previous chunk is written
+    // in the background, so only two chunks are held in memory. The content is
+    // identical to what parallel_generate produces with given seed. Zero
+    // thread_count means the hardware concurrency.
+    template<typename T, typename Engine = std::mt19937_64>
+    void write_normal_npy(
+        std::string const& path,
+        std::vector<std::uint64_t> const& shape,
+        std::uint64_t seed,
+        typename ziggurat_normal_distribution<T>::param_type const& param,
+        std::size_t thread_count = 0
+    )
+    {
+        constexpr std::size_t chunk_size = ziggurat_detail::npy_chunk_size;
+
+        npy_writer<T> writer{path, shape};
+
+        std::uint64_t size = 1;
+        for (auto const dim : shape) {
+            size *= dim;
+        }
+        thread_count = ziggurat_detail::resolve_thread_count(
+            thread_count, chunk_size / ziggurat_detail::parallel_block_size
+        );
+
+        auto produce = [&](std::uint64_t chunk, std::vector<T>& buffer) {
+            auto const offset = chunk * chunk_size;
+            buffer.resize(std::size_t(std::min<std::uint64_t>(size - offset, chunk_size)));
+            ziggurat_detail::fill_parallel_chunk<Engine>(
+                buffer.data(), offset, buffer.size(), seed, param, thread_count
+            );
+        };
+
+        auto consume = [&](std::vector<T> const& buffer) {
+            writer.write(buffer.data(), buffer.size());
+        };
+
+        ziggurat_detail::double_buffered<std::vector<T>>(
+            (size + chunk_size - 1) / chunk_size, produce, consume
+        );
+        writer.close();
+    }
+
+    // write_normal_npy writes an NPY file at path holding a C-order array of
+    // given shape filled with standard normal random numbers.
+    template<typename T, typename Engine = std::mt19937_64>
+    void write_normal_npy(
+        std::string const& path,
+        std::vector<std::uint64_t> const& shape,
+        std::uint64_t seed,
+        std::size_t thread_count = 0
+    )
+    {
+        using param_type = typename ziggurat_normal_distribution<T>::param_type;
+
+        write_normal_npy<T, Engine>(path, shape, seed, param_type{}, thread_count);
+    }
+}
+
+#endif
@@ -0,0 +1,1037 @@
+// Parallel normal random number generation
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_PARALLEL_HPP
+#define INCLUDED_ZIGGURAT_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+# include <sched.h>
+#endif
+
+#if defined(ZIGGURAT_USE_LIBNUMA)
+# include <numa.h>
+#endif
+
+#include "ziggurat.hpp"
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // cache_line_size is the assumed size of a cache line.
+        constexpr std::size_t cache_line_size = 64;
+
+        // cache_padded holds a value followed by a cache line of padding, so
+        // that the value never shares a cache line with the next member. It is
+        // used instead of alignas since C++11 new ignores extended alignment.
+        template<typename T>
+        struct cache_padded
+        {
+            T value;
+            char padding[cache_line_size];
+        };
+
+        // parallel_block_size is the number of elements in a logical block of
+        // parallel generation. Each block is filled using its own engine, so
+        // changing this value changes the generated sequence.
+        constexpr std::size_t parallel_block_size = 16384;
+
+        // mix_bits scrambles the bits of num (splitmix64 finalizer).
+        inline std::uint64_t mix_bits(std::uint64_t num)
+        {
+            num += 0x9E3779B97F4A7C15;
+            num = (num ^ (num >> 30)) * 0xBF58476D1CE4E5B9;
+            num = (num ^ (num >> 27)) * 0x94D049BB133111EB;
+            return num ^ (num >> 31);
+        }
+
+        // stream_seed derives the seed of the index-th engine stream from a
+        // base seed.
+        inline std::uint64_t stream_seed(std::uint64_t seed, std::uint64_t index)
+        {
+            return mix_bits(mix_bits(seed) ^ index);
+        }
+
+        // thread_generator is a pair of engine and normal distribution owned by
+        // a thread. It occupies its own cache lines to avoid false sharing.
+        template<typename T, typename Engine>
+        struct alignas(cache_line_size) thread_generator
+        {
+            Engine engine;
+            ziggurat_normal_distribution<T> normal;
+
+            explicit thread_generator(std::uint64_t seed)
+                : engine{typename Engine::result_type(seed)}
+            {
+            }
+        };
+
+        // thread_normal_seed returns the base seed of thread generators.
+        inline std::atomic<std::uint64_t>& thread_normal_seed()
+        {
+            static std::atomic<std::uint64_t> seed{0};
+            return seed;
+        }
+
+        // thread_index returns the index of the calling thread. Indices are
+        // assigned sequentially in the order of the first call.
+        inline std::uint64_t thread_index()
+        {
+            static std::atomic<std::uint64_t> next_index{0};
+            thread_local std::uint64_t const index = next_index.fetch_add(1);
+            return index;
+        }
+
+        // get_thread_generator returns the generator of the calling thread,
+        // creating it on first use.
+        template<typename T, typename Engine>
+        thread_generator<T, Engine>& get_thread_generator()
+        {
+            thread_local thread_generator<T, Engine> generator{
+                stream_seed(thread_normal_seed().load(), thread_index())
+            };
+            return generator;
+        }
+
+        // resolve_thread_count returns the number of threads to use for given
+        // number of tasks. Zero thread_count means the hardware concurrency.
+        inline std::size_t resolve_thread_count(std::size_t thread_count, std::size_t task_count)
+        {
+            if (thread_count == 0) {
+                thread_count = std::thread::hardware_concurrency();
+            }
+            return std::max(std::size_t(1), std::min(thread_count, task_count));
+        }
+
+        // round_up_pow2 returns the smallest power of two not less than num.
+        inline std::size_t round_up_pow2(std::size_t num)
+        {
+            std::size_t pow2 = 1;
+            while (pow2 < num) {
+                pow2 *= 2;
+            }
+            return pow2;
+        }
+
+        // backoff waits a bit in a polling loop. It yields the processor for
+        // the first few rounds and then sleeps.
+        class backoff
+        {
+        public:
+            void operator()()
+            {
+                if (round_ < yield_rounds) {
+                    round_++;
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+
+            void reset()
+            {
+                round_ = 0;
+            }
+
+        private:
+            static constexpr int yield_rounds = 16;
+            int round_ = 0;
+        };
+
+        // first_error keeps the first exception thrown in worker threads so
+        // that it can be rethrown in the calling thread.
+        class first_error
+        {
+        public:
+            // capture stores the current exception if none is stored yet.
+            void capture()
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+
+            // rethrow rethrows the stored exception if any.
+            void rethrow() const
+            {
+                if (error_) {
+                    std::rethrow_exception(error_);
+                }
+            }
+
+        private:
+            std::mutex mutex_;
+            std::exception_ptr error_;
+        };
+
+        // run_tasks invokes task(i) for each i taken from next_task until it
+        // reaches task_count. The counter is exhausted on error so that other
+        // threads stop early.
+        template<typename F>
+        void run_tasks(
+            std::atomic<std::size_t>& next_task,
+            std::size_t task_count,
+            F& task,
+            first_error& error
+        )
+        {
+            try {
+                for (;;) {
+                    auto const i = next_task.fetch_add(1, std::memory_order_relaxed);
+                    if (i >= task_count) {
+                        break;
+                    }
+                    task(i);
+                }
+            } catch (...) {
+                error.capture();
+                next_task.store(task_count, std::memory_order_relaxed);
+            }
+        }
+
+        // run_parallel invokes task(i) for each i in [0, task_count) using
+        // thread_count threads including the calling thread. Tasks are handed
+        // out dynamically. An exception thrown from a task is rethrown in the
+        // calling thread after all threads finish.
+        template<typename F>
+        void run_parallel(std::size_t task_count, std::size_t thread_count, F task)
+        {
+            std::atomic<std::size_t> next_task{0};
+            first_error error;
+
+            auto worker = [&] {
+                run_tasks(next_task, task_count, task, error);
+            };
+
+            std::vector<std::thread> threads;
+            for (std::size_t i = 1; i < thread_count; i++) {
+                threads.emplace_back(worker);
+            }
+            worker();
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            error.rethrow();
+        }
+
+        // fill_stream_block fills the range [first, last) with the numbers of
+        // the block-th logical block of parallel generation.
+        template<typename Engine, typename RandomAccessIterator>
+        void fill_stream_block(
+            RandomAccessIterator first,
+            RandomAccessIterator last,
+            std::size_t block,
+            std::uint64_t seed,
+            typename ziggurat_normal_distribution<
+                typename std::iterator_traits<RandomAccessIterator>::value_type
+            >::param_type const& param
+        )
+        {
+            using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+            using seed_type = typename Engine::result_type;
+
+            Engine engine{seed_type(stream_seed(seed, block))};
+            ziggurat_normal_distribution<value_type> normal{param};
+            normal.generate(first, last, engine);
+        }
+
+        // fill_parallel_block fills the block-th logical block of the range
+        // of given size starting at first. The range is treated as starting
+        // at the first_block-th block of a larger sequence.
+        template<typename Engine, typename RandomAccessIterator>
+        void fill_parallel_block(
+            RandomAccessIterator first,
+            std::size_t size,
+            std::size_t block,
+            std::uint64_t seed,
+            typename ziggurat_normal_distribution<
+                typename std::iterator_traits<RandomAccessIterator>::value_type
+            >::param_type const& param,
+            std::size_t first_block = 0
+        )
+        {
+            using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+
+            auto const block_begin = block * parallel_block_size;
+            auto const block_end = std::min(block_begin + parallel_block_size, size);
+
+            fill_stream_block<Engine>(
+                first + difference_type(block_begin),
+                first + difference_type(block_end),
+                first_block + block,
+                seed,
+                param
+            );
+        }
+
+        // fill_parallel_chunk fills the range [first, first + count) with the
+        // numbers of parallel generation starting at offset, which must be a
+        // multiple of the parallel block size, using thread_count threads.
+        template<typename Engine, typename RandomAccessIterator>
+        void fill_parallel_chunk(
+            RandomAccessIterator first,
+            std::uint64_t offset,
+            std::size_t count,
+            std::uint64_t seed,
+            typename ziggurat_normal_distribution<
+                typename std::iterator_traits<RandomAccessIterator>::value_type
+            >::param_type const& param,
+            std::size_t thread_count
+        )
+        {
+            auto const first_block = std::size_t(offset / parallel_block_size);
+            auto const block_count = (count + parallel_block_size - 1) / parallel_block_size;
+
+            auto fill_block = [&](std::size_t block) {
+                fill_parallel_block<Engine>(first, count, block, seed, param, first_block);
+            };
+            run_parallel(block_count, std::min(thread_count, block_count), fill_block);
+        }
+
+        // double_buffered invokes produce(i, buffer) for each chunk i in
+        // [0, chunk_count) in the calling thread, and consume(buffer) for the
+        // produced buffer in the background while the next chunk is being
+        // produced. Two buffers of type Buffer are used alternately.
+        template<typename Buffer, typename Produce, typename Consume>
+        void double_buffered(std::uint64_t chunk_count, Produce produce, Consume consume)
+        {
+            Buffer buffers[2];
+            std::future<void> pending;
+
+            for (std::uint64_t chunk = 0; chunk < chunk_count; chunk++) {
+                auto& buffer = buffers[chunk % 2];
+                produce(chunk, buffer);
+
+                if (pending.valid()) {
+                    pending.get();
+                }
+                pending = std::async(std::launch::async, [&consume, &buffer] {
+                    consume(buffer);
+                });
+            }
+
+            if (pending.valid()) {
+                pending.get();
+            }
+        }
+
+        // chase_lev_deque is a growable work-stealing deque of pointers (Chase
+        // and Lev 2005, with the memory orderings of Le et al. 2013). The owner
+        // thread pushes and pops items at the bottom, and other threads steal
+        // items from the top.
+        template<typename T>
+        class chase_lev_deque
+        {
+        public:
+            explicit chase_lev_deque(std::size_t capacity = 64)
+            {
+                arrays_.emplace_back(new ring{round_up_pow2(capacity)});
+                array_.store(arrays_.back().get(), std::memory_order_relaxed);
+            }
+
+            // push adds item to the bottom. Owner only.
+            void push(T* item)
+            {
+                auto const bottom = bottom_.value.load(std::memory_order_relaxed);
+                auto const top = top_.value.load(std::memory_order_acquire);
+                auto array = array_.load(std::memory_order_relaxed);
+
+                if (bottom - top > std::int64_t(array->mask)) {
+                    array = grow(array, top, bottom);
+                }
+
+                array->put(bottom, item);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom_.value.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            // pop removes an item from the bottom, or returns nullptr if the
+            // deque is empty. Owner only.
+            T* pop()
+            {
+                auto const bottom = bottom_.value.load(std::memory_order_relaxed) - 1;
+                auto const array = array_.load(std::memory_order_relaxed);
+                bottom_.value.store(bottom, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto top = top_.value.load(std::memory_order_relaxed);
+
+                if (top > bottom) {
+                    bottom_.value.store(bottom + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                T* item = array->get(bottom);
+
+                if (top == bottom) {
+                    // Last item: race against thieves.
+                    if (!top_.value.compare_exchange_strong(
+                        top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+                    )) {
+                        item = nullptr;
+                    }
+                    bottom_.value.store(bottom + 1, std::memory_order_relaxed);
+                }
+
+                return item;
+            }
+
+            // steal removes an item from the top, or returns nullptr if the
+            // deque is empty or another thread won the race for the item.
+            T* steal()
+            {
+                auto top = top_.value.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto const bottom = bottom_.value.load(std::memory_order_acquire);
+
+                if (top >= bottom) {
+                    return nullptr;
+                }
+
+                auto const array = array_.load(std::memory_order_acquire);
+                T* item = array->get(top);
+
+                if (!top_.value.compare_exchange_strong(
+                    top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+                )) {
+                    return nullptr;
+                }
+                return item;
+            }
+
+        private:
+            struct ring
+            {
+                explicit ring(std::size_t capacity)
+                    : mask{capacity - 1}, items{new std::atomic<T*>[capacity]}
+                {
+                }
+
+                T* get(std::int64_t i) const
+                {
+                    return items[std::size_t(i) & mask].load(std::memory_order_relaxed);
+                }
+
+                void put(std::int64_t i, T* item)
+                {
+                    items[std::size_t(i) & mask].store(item, std::memory_order_relaxed);
+                }
+
+                std::size_t mask;
+                std::unique_ptr<std::atomic<T*>[]> items;
+            };
+
+            // grow replaces the array with a twice larger copy. Old arrays are
+            // kept alive because thieves may still be reading them.
+            ring* grow(ring* array, std::int64_t top, std::int64_t bottom)
+            {
+                arrays_.emplace_back(new ring{2 * (array->mask + 1)});
+                auto const bigger = arrays_.back().get();
+
+                for (auto i = top; i < bottom; i++) {
+                    bigger->put(i, array->get(i));
+                }
+                array_.store(bigger, std::memory_order_release);
+
+                return bigger;
+            }
+
+            // Value-initialized to zero.
+            cache_padded<std::atomic<std::int64_t>> top_{};
+            cache_padded<std::atomic<std::int64_t>> bottom_{};
+            std::atomic<ring*> array_;
+            std::vector<std::unique_ptr<ring>> arrays_;
+        };
+
+        // work_stealing_scheduler runs tasks on a fixed number of threads.
+        // Each thread owns a deque of tasks, and idle threads steal tasks
+        // from the others. A task may spawn subtasks onto the deque of its
+        // thread. The owner pops the newest task and thieves steal the
+        // oldest, so when a task halves its range repeatedly and spawns the
+        // second halves, the owner works on the small pieces and thieves
+        // take the large ones.
+        template<typename Task>
+        class work_stealing_scheduler
+        {
+            struct worker;
+
+        public:
+            // context is passed to a running task to spawn subtasks.
+            class context
+            {
+            public:
+                // spawn schedules task to be run after or in parallel with
+                // the current task.
+                void spawn(Task const& task)
+                {
+                    pending_.fetch_add(1, std::memory_order_relaxed);
+                    worker_.arena.push_back(task);
+                    worker_.deque.push(&worker_.arena.back());
+                }
+
+            private:
+                friend class work_stealing_scheduler;
+
+                context(worker& self, std::atomic<std::size_t>& pending)
+                    : worker_(self), pending_(pending)
+                {
+                }
+
+                worker& worker_;
+                std::atomic<std::size_t>& pending_;
+            };
+
+            // run executes tasks and all the subtasks spawned from them using
+            // thread_count threads including the calling thread, and waits for
+            // the completion. execute(task, context) is called for each task.
+            // An exception thrown from a task is rethrown in the calling
+            // thread and the remaining tasks are skipped.
+            template<typename F>
+            static void run(std::vector<Task> tasks, std::size_t thread_count, F execute)
+            {
+                thread_count = std::max(thread_count, std::size_t(1));
+
+                std::vector<std::unique_ptr<worker>> workers;
+                for (std::size_t i = 0; i < thread_count; i++) {
+                    workers.emplace_back(new worker{mix_bits(i)});
+                }
+                for (std::size_t i = 0; i < tasks.size(); i++) {
+                    workers[i % thread_count]->deque.push(&tasks[i]);
+                }
+
+                std::atomic<std::size_t> pending{tasks.size()};
+                std::atomic<bool> aborted{false};
+                first_error error;
+
+                auto work = [&](std::size_t id) {
+                    auto& self = *workers[id];
+                    context ctx{self, pending};
+                    backoff wait;
+
+                    while (pending.load(std::memory_order_acquire) > 0) {
+                        Task* task = self.deque.pop();
+
+                        if (!task) {
+                            task = steal(workers, self);
+                        }
+                        if (!task) {
+                            wait();
+                            continue;
+                        }
+                        wait.reset();
+
+                        if (!aborted.load(std::memory_order_relaxed)) {
+                            try {
+                                execute(*task, ctx);
+                            } catch (...) {
+                                error.capture();
+                                aborted.store(true, std::memory_order_relaxed);
+                            }
+                        }
+                        pending.fetch_sub(1, std::memory_order_acq_rel);
+                    }
+                };
+
+                std::vector<std::thread> threads;
+                for (std::size_t i = 1; i < thread_count; i++) {
+                    threads.emplace_back(work, i);
+                }
+                work(0);
+
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+
+                error.rethrow();
+            }
+
+        private:
+            struct worker
+            {
+                explicit worker(std::uint64_t seed)
+                    : random_state{seed}
+                {
+                }
+
+                chase_lev_deque<Task> deque;
+                std::deque<Task> arena;
+                std::uint64_t random_state;
+            };
+
+            // steal tries to steal a task from the workers other than self,
+            // starting from a random victim.
+            static Task* steal(std::vector<std::unique_ptr<worker>>& workers, worker& self)
+            {
+                auto const count = workers.size();
+
+                // xorshift64
+                self.random_state ^= self.random_state << 13;
+                self.random_state ^= self.random_state >> 7;
+                self.random_state ^= self.random_state << 17;
+
+                auto const start = std::size_t(self.random_state % count);
+
+                for (std::size_t i = 0; i < count; i++) {
+                    auto& victim = *workers[(start + i) % count];
+                    if (&victim == &self) {
+                        continue;
+                    }
+                    if (Task* task = victim.deque.steal()) {
+                        return task;
+                    }
+                }
+                return nullptr;
+            }
+        };
+
+        // parse_cpu_list parses a list of CPU ranges like "0-3,8,10-11".
+        inline std::vector<int> parse_cpu_list(std::string const& text)
+        {
+            std::vector<int> cpus;
+            std::istringstream stream{text};
+            std::string range;
+
+            while (std::getline(stream, range, ',')) {
+                std::istringstream range_stream{range};
+                int first_cpu;
+                int last_cpu;
+                char dash;
+
+                if (!(range_stream >> first_cpu)) {
+                    continue;
+                }
+                if (!(range_stream >> dash >> last_cpu) || dash != '-') {
+                    last_cpu = first_cpu;
+                }
+                for (int cpu = first_cpu; cpu <= last_cpu; cpu++) {
+                    cpus.push_back(cpu);
+                }
+            }
+
+            return cpus;
+        }
+
+        // bind_thread restricts the calling thread to run on given CPUs. It
+        // does nothing if cpus is empty or the platform does not support it.
+        inline void bind_thread(std::vector<int> const& cpus)
+        {
+#if defined(__linux__)
+            if (cpus.empty()) {
+                return;
+            }
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpus) {
+                if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                    CPU_SET(std::size_t(cpu), &set);
+                }
+            }
+            sched_setaffinity(0, sizeof set, &set);
+#else
+            (void) cpus;
+#endif
+        }
+    }
+
+    // parallel_generate fills the range [first, last) with normal random
+    // numbers with given parameters using multiple threads. The range is
+    // partitioned into fixed-size blocks and each block is filled with an
+    // Engine seeded by a seed derived from the given seed and the block
+    // index. So the result only depends on the seed and is bitwise identical
+    // regardless of the number of threads. Zero thread_count means the
+    // hardware concurrency.
+    template<typename Engine = std::mt19937_64, typename RandomAccessIterator>
+    void parallel_generate(
+        RandomAccessIterator first,
+        RandomAccessIterator last,
+        std::uint64_t seed,
+        typename ziggurat_normal_distribution<
+            typename std::iterator_traits<RandomAccessIterator>::value_type
+        >::param_type const& param,
+        std::size_t thread_count = 0
+    )
+    {
+        constexpr std::size_t block_size = ziggurat_detail::parallel_block_size;
+
+        auto const size = std::size_t(last - first);
+        auto const block_count = (size + block_size - 1) / block_size;
+
+        auto fill_block = [&](std::size_t block) {
+            ziggurat_detail::fill_parallel_block<Engine>(first, size, block, seed, param);
+        };
+
+        ziggurat_detail::run_parallel(
+            block_count,
+            ziggurat_detail::resolve_thread_count(thread_count, block_count),
+            fill_block
+        );
+    }
+
+    // parallel_generate fills the range [first, last) with standard normal
+    // random numbers using multiple threads.
+    template<typename Engine = std::mt19937_64, typename RandomAccessIterator>
+    void parallel_generate(
+        RandomAccessIterator first,
+        RandomAccessIterator last,
+        std::uint64_t seed,
+        std::size_t thread_count = 0
+    )
+    {
+        using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        using param_type = typename ziggurat_normal_distribution<value_type>::param_type;
+
+        parallel_generate<Engine>(first, last, seed, param_type{}, thread_count);
+    }
+
+    // generate_request describes a range [first, last) to be filled with
+    // normal random numbers with given parameters.
+    template<typename T>
+    struct generate_request
+    {
+        using param_type = typename ziggurat_normal_distribution<T>::param_type;
+
+        T* first;
+        T* last;
+        param_type param;
+
+        generate_request(T* first_, T* last_, param_type const& param_ = param_type{})
+            : first{first_}, last{last_}, param{param_}
+        {
+        }
+    };
+
+    // parallel_generate fills the ranges of a batch of requests, which may
+    // vary widely in size, using multiple threads. The requests are split
+    // into chunks of the parallel block size and are balanced across threads
+    // by work stealing. The k-th chunk of the i-th request is filled with an
+    // Engine seeded by a seed derived from the given seed, i and k, so the
+    // result only depends on the seed and the sizes of the requests.
+    template<typename Engine = std::mt19937_64, typename T>
+    void parallel_generate(
+        std::vector<generate_request<T>> const& requests,
+        std::uint64_t seed,
+        std::size_t thread_count = 0
+    )
+    {
+        using seed_type = typename Engine::result_type;
+
+        constexpr std::size_t chunk_size = ziggurat_detail::parallel_block_size;
+
+        // A task fills the chunks [begin, end) of a request.
+        struct task
+        {
+            std::size_t request;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        std::vector<task> tasks;
+        std::size_t total_chunk_count = 0;
+
+        for (std::size_t i = 0; i < requests.size(); i++) {
+            auto const size = std::size_t(requests[i].last - requests[i].first);
+            auto const chunk_count = (size + chunk_size - 1) / chunk_size;
+            if (chunk_count > 0) {
+                tasks.push_back(task{i, 0, chunk_count});
+                total_chunk_count += chunk_count;
+            }
+        }
+
+        thread_count = ziggurat_detail::resolve_thread_count(thread_count, total_chunk_count);
+
+        using scheduler = ziggurat_detail::work_stealing_scheduler<task>;
+
+        auto execute = [&](task t, typename scheduler::context& ctx) {
+            // Halve eagerly down to a single chunk, spawning the second
+            // halves. The larger halves are spawned first and so are the
+            // ones that other threads steal.
+            while (t.end - t.begin > 1) {
+                auto const mid = t.begin + (t.end - t.begin) / 2;
+                ctx.spawn(task{t.request, mid, t.end});
+                t.end = mid;
+            }
+
+            auto const& request = requests[t.request];
+            auto const size = std::size_t(request.last - request.first);
+            auto const chunk_begin = t.begin * chunk_size;
+            auto const chunk_end = std::min(chunk_begin + chunk_size, size);
+
+            auto const stream = ziggurat_detail::stream_seed(seed, t.request);
+            Engine engine{seed_type(ziggurat_detail::stream_seed(stream, t.begin))};
+            ziggurat_normal_distribution<T> normal{request.param};
+
+            normal.generate(request.first + chunk_begin, request.first + chunk_end, engine);
+        };
+
+        scheduler::run(std::move(tasks), thread_count, execute);
+    }
+
+    // seed_thread_normal sets the base seed of the per-thread generators used
+    // by thread_normal. It only affects generators created afterwards, so call
+    // it before starting threads.
+    inline void seed_thread_normal(std::uint64_t seed)
+    {
+        ziggurat_detail::thread_normal_seed().store(seed);
+    }
+
+    // thread_normal returns a standard normal random number generated by the
+    // calling thread's own engine. The engine is created on first use and
+    // seeded deterministically from the base seed and the index of the thread,
+    // which is assigned in the order in which threads first call thread_normal.
+    template<typename T, typename Engine = std::mt19937_64>
+    T thread_normal()
+    {
+        auto& generator = ziggurat_detail::get_thread_generator<T, Engine>();
+        return generator.normal(generator.engine);
+    }
+
+    // thread_normal returns a normal random number with given parameters
+    // generated by the calling thread's own engine.
+    template<typename T, typename Engine = std::mt19937_64>
+    T thread_normal(typename ziggurat_normal_distribution<T>::param_type const& param)
+    {
+        auto& generator = ziggurat_detail::get_thread_generator<T, Engine>();
+        return generator.normal(generator.engine, param);
+    }
+
+    // numa_node describes a NUMA node. Empty cpus means that threads working
+    // for the node are not bound to any CPU.
+    struct numa_node
+    {
+        int id = 0;
+        std::vector<int> cpus;
+    };
+
+    // numa_topology lists NUMA nodes having CPUs. It may be detected from the
+    // system or built by hand to simulate a topology.
+    struct numa_topology
+    {
+        std::vector<numa_node> nodes;
+    };
+
+    // detect_numa_topology returns the NUMA topology of the system. It uses
+    // libnuma if ZIGGURAT_USE_LIBNUMA is defined (link with -lnuma) and reads
+    // sysfs otherwise. A single unbound node is returned if the topology is
+    // not available.
+    inline numa_topology detect_numa_topology()
+    {
+        numa_topology topology;
+
+#if defined(ZIGGURAT_USE_LIBNUMA)
+        if (numa_available() >= 0) {
+            auto const cpu_mask = numa_allocate_cpumask();
+            auto const cpu_count = numa_num_possible_cpus();
+
+            for (int id = 0; id <= numa_max_node(); id++) {
+                numa_node node;
+                node.id = id;
+
+                if (numa_node_to_cpus(id, cpu_mask) == 0) {
+                    for (int cpu = 0; cpu < cpu_count; cpu++) {
+                        if (numa_bitmask_isbitset(cpu_mask, unsigned(cpu))) {
+                            node.cpus.push_back(cpu);
+                        }
+                    }
+                }
+                if (!node.cpus.empty()) {
+                    topology.nodes.push_back(node);
+                }
+            }
+            numa_free_cpumask(cpu_mask);
+        }
+#else
+        std::ifstream online{"/sys/devices/system/node/online"};
+        std::string online_list;
+
+        if (std::getline(online, online_list)) {
+            for (int id : ziggurat_detail::parse_cpu_list(online_list)) {
+                std::ifstream cpulist{
+                    "/sys/devices/system/node/node" + std::to_string(id) + "/cpulist"
+                };
+                std::string cpu_list;
+
+                numa_node node;
+                node.id = id;
+                if (std::getline(cpulist, cpu_list)) {
+                    node.cpus = ziggurat_detail::parse_cpu_list(cpu_list);
+                }
+                if (!node.cpus.empty()) {
+                    topology.nodes.push_back(node);
+                }
+            }
+        }
+#endif
+
+        if (topology.nodes.empty()) {
+            topology.nodes.push_back(numa_node{});
+        }
+        return topology;
+    }
+
+    // numa_partition splits a range of given size into contiguous subranges
+    // for the nodes of a topology, proportionally to the number of CPUs. The
+    // subranges are aligned to the logical blocks of parallel generation. It
+    // returns the [begin, end) offsets of the subrange of each node.
+    inline std::vector<std::pair<std::size_t, std::size_t>> numa_partition(
+        std::size_t size,
+        numa_topology const& topology
+    )
+    {
+        constexpr std::size_t block_size = ziggurat_detail::parallel_block_size;
+
+        auto const block_count = (size + block_size - 1) / block_size;
+
+        auto weight = [](numa_node const& node) {
+            return std::max(node.cpus.size(), std::size_t(1));
+        };
+
+        std::size_t total_weight = 0;
+        for (auto const& node : topology.nodes) {
+            total_weight += weight(node);
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        std::size_t cumulative_weight = 0;
+        std::size_t begin = 0;
+
+        for (auto const& node : topology.nodes) {
+            cumulative_weight += weight(node);
+            auto const end_block = block_count * cumulative_weight / total_weight;
+            auto const end = std::min(end_block * block_size, size);
+            ranges.emplace_back(begin, end);
+            begin = end;
+        }
+
+        return ranges;
+    }
+
+    // numa_parallel_generate fills the range [first, last) like
+    // parallel_generate, but the subrange given by numa_partition for each
+    // node is filled by threads bound to the CPUs of the node. So the memory
+    // pages are first-touched and allocated on the node that is expected to
+    // consume them. The output is identical to that of parallel_generate.
+    //
+    // The pages must not have been touched before; e.g., std::vector value-
+    // initializes its elements in the calling thread.
+    template<typename Engine = std::mt19937_64, typename RandomAccessIterator>
+    void numa_parallel_generate(
+        RandomAccessIterator first,
+        RandomAccessIterator last,
+        std::uint64_t seed,
+        numa_topology const& topology,
+        typename ziggurat_normal_distribution<
+            typename std::iterator_traits<RandomAccessIterator>::value_type
+        >::param_type const& param
+    )
+    {
+        constexpr std::size_t block_size = ziggurat_detail::parallel_block_size;
+
+        auto const size = std::size_t(last - first);
+        auto const ranges = numa_partition(size, topology);
+        auto const node_count = topology.nodes.size();
+
+        std::vector<std::atomic<std::size_t>> next_blocks(node_count);
+        ziggurat_detail::first_error error;
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 0; i < node_count; i++) {
+            next_blocks[i].store(0);
+
+            if (ranges[i].first == ranges[i].second) {
+                continue;
+            }
+
+            auto const& node = topology.nodes[i];
+            auto const begin_block = ranges[i].first / block_size;
+            auto const end_block = (ranges[i].second + block_size - 1) / block_size;
+            auto const block_count = end_block - begin_block;
+            auto const thread_count = std::min(
+                std::max(node.cpus.size(), std::size_t(1)), block_count
+            );
+
+            for (std::size_t j = 0; j < thread_count; j++) {
+                threads.emplace_back([&, i, begin_block, block_count] {
+                    ziggurat_detail::bind_thread(topology.nodes[i].cpus);
+
+                    auto fill_block = [&](std::size_t block) {
+                        ziggurat_detail::fill_parallel_block<Engine>(
+                            first, size, begin_block + block, seed, param
+                        );
+                    };
+                    ziggurat_detail::run_tasks(next_blocks[i], block_count, fill_block, error);
+                });
+            }
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        error.rethrow();
+    }
+
+    // numa_parallel_generate fills the range [first, last) with standard
+    // normal random numbers in a NUMA-aware way.
+    template<typename Engine = std::mt19937_64, typename RandomAccessIterator>
+    void numa_parallel_generate(
+        RandomAccessIterator first,
+        RandomAccessIterator last,
+        std::uint64_t seed,
+        numa_topology const& topology = detect_numa_topology()
+    )
+    {
+        using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        using param_type = typename ziggurat_normal_distribution<value_type>::param_type;
+
+        numa_parallel_generate<Engine>(first, last, seed, topology, param_type{});
+    }
+}
+
+#endif
@@ -0,0 +1,513 @@
+// Sample paths of stochastic processes driven by ziggurat normal numbers
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_PROCESS_HPP
+#define INCLUDED_ZIGGURAT_PROCESS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ziggurat.hpp"
+#include "ziggurat_lognormal.hpp"
+
+
+namespace cxx
+{
+    // path_layout selects the memory layout of a batch of sample paths of a
+    // stochastic process. With path_major, the points of a path are
+    // contiguous: the t-th point of the p-th path is at p * point_count + t.
+    // With step_major, the points of all paths at a time step are
+    // contiguous: the same point is at t * path_count + p.
+    enum class path_layout
+    {
+        path_major,
+        step_major
+    };
+
+    // gbm_path_generator generates sample paths of the geometric Brownian
+    // motion dS = mu S dt + sigma S dW with a fixed time step. Each path
+    // consists of the initial value followed by step_count points. The
+    // log-increments are drawn by the bulk ziggurat kernel and exponentiated
+    // by a vectorized exp, and paths are written directly to the output
+    // without any temporary allocation.
+    template<typename T>
+    class gbm_path_generator
+    {
+    public:
+        // This constructor creates a generator of paths starting at s0 with
+        // given drift mu, volatility sigma, time step dt and number of steps.
+        gbm_path_generator(
+            T s0,
+            T mu,
+            T sigma,
+            T dt,
+            std::size_t step_count,
+            path_layout layout = path_layout::path_major
+        )
+            : s0_{s0}
+            , increment_{(mu - sigma * sigma / 2) * dt, sigma * std::sqrt(dt)}
+            , step_count_{step_count}
+            , layout_{layout}
+        {
+        }
+
+        // step_count returns the number of time steps of a path.
+        std::size_t step_count() const
+        {
+            return step_count_;
+        }
+
+        // point_count returns the number of points of a path, which is
+        // step_count() + 1.
+        std::size_t point_count() const
+        {
+            return step_count_ + 1;
+        }
+
+        // layout returns the memory layout of generated paths.
+        path_layout layout() const
+        {
+            return layout_;
+        }
+
+        // generate writes path_count paths to the array out, which must have
+        // room for path_count * point_count() numbers. The two layouts
+        // consume the engine in different orders and hence produce
+        // different paths.
+        template<typename URNG>
+        void generate(T* out, std::size_t path_count, URNG& random)
+        {
+            if (layout_ == path_layout::path_major) {
+                generate_path_major(out, path_count, random);
+            } else {
+                generate_step_major(out, path_count, random);
+            }
+        }
+
+    private:
+        // Each path is a cumulative sum of log-increments, exponentiated.
+        template<typename URNG>
+        void generate_path_major(T* out, std::size_t path_count, URNG& random)
+        {
+            auto const log_s0 = std::log(s0_);
+
+            for (std::size_t p = 0; p < path_count; p++) {
+                auto const path = out + p * point_count();
+
+                normal_.generate(path + 1, path + point_count(), random, increment_);
+
+                path[0] = log_s0;
+                for (std::size_t t = 1; t < point_count(); t++) {
+                    path[t] += path[t - 1];
+                }
+                ziggurat_detail::exp_block(path + 1, step_count_);
+                path[0] = s0_;
+            }
+        }
+
+        // Each step multiplies the previous row by a row of lognormal
+        // factors, which is vectorized across paths.
+        template<typename URNG>
+        void generate_step_major(T* out, std::size_t path_count, URNG& random)
+        {
+            for (std::size_t p = 0; p < path_count; p++) {
+                out[p] = s0_;
+            }
+
+            for (std::size_t t = 1; t < point_count(); t++) {
+                auto const prev = out + (t - 1) * path_count;
+                auto const row = out + t * path_count;
+
+                normal_.generate(row, row + path_count, random, increment_);
+                ziggurat_detail::exp_block(row, path_count);
+
+                for (std::size_t p = 0; p < path_count; p++) {
+                    row[p] *= prev[p];
+                }
+            }
+        }
+
+        T s0_;
+        typename ziggurat_normal_distribution<T>::param_type increment_;
+        std::size_t step_count_;
+        path_layout layout_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+
+    // brownian_construction selects how brownian_path_generator builds
+    // paths from standard normal numbers. With incremental, the k-th normal
+    // number of a path drives the increment from the (k-1)-th to the k-th
+    // point. With bridge, the first normal number fixes the last point and
+    // the following ones fill in midpoints of ever finer intervals by the
+    // Brownian bridge, so the leading numbers determine the coarse shape of
+    // a path. The bridge ordering suits quasi-Monte Carlo points, whose
+    // leading coordinates are the most uniform.
+    enum class brownian_construction
+    {
+        incremental,
+        bridge
+    };
+
+    // brownian_path_generator generates sample paths of the standard
+    // Brownian motion W with W(0) = 0 at the points of an arbitrary time
+    // grid. Paths are generated in the step_major layout: W(t_k) of all
+    // paths is contiguous, so every construction step is a loop across
+    // paths that vectorizes. The construction coefficients are computed
+    // once for the grid, and paths are built in place in the output from
+    // rows of bulk ziggurat normals without any temporary allocation.
+    template<typename T>
+    class brownian_path_generator
+    {
+    public:
+        // This constructor creates a generator of paths evaluated at given
+        // times, which must be non-negative and strictly increasing. Throws
+        // std::invalid_argument if times is empty or not increasing.
+        explicit brownian_path_generator(
+            std::vector<T> const& times,
+            brownian_construction construction = brownian_construction::incremental
+        )
+            : times_{times}, construction_{construction}
+        {
+            if (times.empty() || !(times[0] >= 0)) {
+                throw std::invalid_argument("time grid must be non-empty and start at t >= 0");
+            }
+            for (std::size_t k = 1; k < times.size(); k++) {
+                if (!(times[k] > times[k - 1])) {
+                    throw std::invalid_argument("time grid must be strictly increasing");
+                }
+            }
+
+            if (construction == brownian_construction::incremental) {
+                plan_increments();
+            } else {
+                plan_bridge();
+            }
+        }
+
+        // point_count returns the number of points of a path, which is the
+        // number of times in the grid.
+        std::size_t point_count() const
+        {
+            return times_.size();
+        }
+
+        // times returns the time grid.
+        std::vector<T> const& times() const
+        {
+            return times_;
+        }
+
+        // construction returns the construction of paths.
+        brownian_construction construction() const
+        {
+            return construction_;
+        }
+
+        // generate writes path_count paths to the array out, which must have
+        // room for path_count * point_count() numbers. W(t_k) of the p-th
+        // path is stored at out[k * path_count + p].
+        template<typename URNG>
+        void generate(T* out, std::size_t path_count, URNG& random)
+        {
+            for (auto const& step : steps_) {
+                auto const row = out + step.point * path_count;
+                normal_.generate(row, row + path_count, random);
+                apply(step, row, out, path_count);
+            }
+        }
+
+        // transform builds path_count paths in out from given standard
+        // normal numbers, such as quasi-Monte Carlo points mapped by the
+        // inverse normal CDF. The j-th normal number of the p-th path is
+        // read from normals[j * path_count + p], and the output layout is the
+        // one of generate. normals and out must not overlap.
+        void transform(T const* normals, T* out, std::size_t path_count) const
+        {
+            for (std::size_t j = 0; j < steps_.size(); j++) {
+                auto const& step = steps_[j];
+                auto const row = out + step.point * path_count;
+                auto const z = normals + j * path_count;
+
+                for (std::size_t p = 0; p < path_count; p++) {
+                    row[p] = z[p];
+                }
+                apply(step, row, out, path_count);
+            }
+        }
+
+    private:
+        // no_point marks the start W(0) = 0 as a neighbor of a point.
+        static constexpr std::size_t no_point = std::size_t(-1);
+
+        // construction_step computes a point of paths from normal numbers z
+        // as W(t_point) = left_weight W(t_left) + right_weight W(t_right) +
+        // scale z. A missing neighbor contributes zero.
+        struct construction_step
+        {
+            std::size_t point;
+            std::size_t left;
+            std::size_t right;
+            T left_weight;
+            T right_weight;
+            T scale;
+        };
+
+        // plan_increments lays out the incremental construction, in which
+        // each point adds an increment to the previous one.
+        void plan_increments()
+        {
+            T prev_time = 0;
+            std::size_t prev = no_point;
+
+            for (std::size_t k = 0; k < times_.size(); k++) {
+                auto const dt = times_[k] - prev_time;
+                steps_.push_back({k, prev, no_point, 1, 0, std::sqrt(dt)});
+                prev_time = times_[k];
+                prev = k;
+            }
+        }
+
+        // plan_bridge lays out the Brownian bridge construction. The last
+        // point comes first and then intervals are bisected breadth-first at
+        // their middle index, so that each level of the bisection refines
+        // the whole path before the next one starts.
+        void plan_bridge()
+        {
+            auto const last = times_.size() - 1;
+
+            steps_.push_back({last, no_point, no_point, 0, 0, std::sqrt(times_[last])});
+
+            // Intervals are pairs of the endpoints, whose interior points are
+            // yet to be constructed. The queue is a vector consumed from the
+            // front.
+            std::vector<std::pair<std::size_t, std::size_t>> intervals;
+            intervals.emplace_back(std::size_t(no_point), last);
+
+            for (std::size_t i = 0; i < intervals.size(); i++) {
+                auto const left = intervals[i].first;
+                auto const right = intervals[i].second;
+
+                // left + 1 wraps no_point to the first index.
+                auto const first = left + 1;
+                if (first >= right) {
+                    continue;
+                }
+                auto const point = first + (right - first) / 2;
+
+                auto const t_left = (left == no_point ? T(0) : times_[left]);
+                auto const t_point = times_[point];
+                auto const t_right = times_[right];
+                auto const span = t_right - t_left;
+
+                steps_.push_back({
+                    point,
+                    left,
+                    right,
+                    (t_right - t_point) / span,
+                    (t_point - t_left) / span,
+                    std::sqrt((t_point - t_left) * (t_right - t_point) / span)
+                });
+
+                intervals.emplace_back(left, point);
+                intervals.emplace_back(point, right);
+            }
+        }
+
+        // apply computes a row of points from the normal numbers stored in
+        // the row itself.
+        static void apply(construction_step const& step, T* row, T const* out, std::size_t path_count)
+        {
+            auto const scale = step.scale;
+
+            if (step.left == no_point && step.right == no_point) {
+                for (std::size_t p = 0; p < path_count; p++) {
+                    row[p] *= scale;
+                }
+            } else if (step.right == no_point) {
+                auto const left = out + step.left * path_count;
+                for (std::size_t p = 0; p < path_count; p++) {
+                    row[p] = left[p] + scale * row[p];
+                }
+            } else if (step.left == no_point) {
+                auto const right = out + step.right * path_count;
+                auto const right_weight = step.right_weight;
+                for (std::size_t p = 0; p < path_count; p++) {
+                    row[p] = right_weight * right[p] + scale * row[p];
+                }
+            } else {
+                auto const left = out + step.left * path_count;
+                auto const right = out + step.right * path_count;
+                auto const left_weight = step.left_weight;
+                auto const right_weight = step.right_weight;
+                for (std::size_t p = 0; p < path_count; p++) {
+                    row[p] = left_weight * left[p] + right_weight * right[p] + scale * row[p];
+                }
+            }
+        }
+
+        std::vector<T> times_;
+        brownian_construction construction_;
+        std::vector<construction_step> steps_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+
+    // ou_stepper advances many independent Ornstein-Uhlenbeck processes
+    // dX = theta (mu - X) dt + sigma dW by a time step dt with the exact
+    // transition
+    //
+    //   X(t + dt) = mu + (X(t) - mu) exp(-theta dt) + s Z,
+    //   s = sigma sqrt((1 - exp(-2 theta dt)) / (2 theta)),
+    //
+    // so that any dt is stable and unbiased. The states are a plain array
+    // updated in place block by block.
+    template<typename T>
+    class ou_stepper
+    {
+    public:
+        // This constructor creates a stepper for the process with given mean
+        // reversion rate theta >= 0, volatility sigma, time step dt and long
+        // term mean mu. theta = 0 gives Brownian motion with volatility
+        // sigma.
+        ou_stepper(T theta, T sigma, T dt, T mu = 0)
+            : theta_{theta}
+            , sigma_{sigma}
+            , dt_{dt}
+            , mu_{mu}
+            , decay_{std::exp(-theta * dt)}
+            , scale_{
+                theta > 0
+                ? sigma * std::sqrt(-std::expm1(-2 * theta * dt) / (2 * theta))
+                : sigma * std::sqrt(dt)
+            }
+        {
+        }
+
+        // theta returns the mean reversion rate.
+        T theta() const
+        {
+            return theta_;
+        }
+
+        // sigma returns the volatility.
+        T sigma() const
+        {
+            return sigma_;
+        }
+
+        // dt returns the time step.
+        T dt() const
+        {
+            return dt_;
+        }
+
+        // mu returns the long term mean.
+        T mu() const
+        {
+            return mu_;
+        }
+
+        // decay returns exp(-theta dt), the factor by which a deviation from
+        // the mean shrinks in a step.
+        T decay() const
+        {
+            return decay_;
+        }
+
+        // noise_scale returns the standard deviation of the noise added in a
+        // step.
+        T noise_scale() const
+        {
+            return scale_;
+        }
+
+        // step advances the count processes in the array state by one time
+        // step. As with generate, splitting the array into calls at
+        // multiples of ziggurat_detail::bulk_block_size does not change the
+        // sequence.
+        template<typename URNG>
+        void step(T* state, std::size_t count, URNG& random)
+        {
+            constexpr std::size_t block = ziggurat_detail::bulk_block_size;
+
+            T noise[block] = {};
+
+            std::size_t i = 0;
+
+            for (; i + block <= count; i += block) {
+                normal_.generate(noise, noise + block, random);
+                update_block(state + i, noise);
+            }
+
+            if (i < count) {
+                auto const tail = count - i;
+                T tail_state[block] = {};
+
+                normal_.generate(noise, noise + tail, random);
+                std::copy(state + i, state + count, tail_state);
+                update_block(tail_state, noise);
+                std::copy(tail_state, tail_state + tail, state + i);
+            }
+        }
+
+        // step advances the count processes in the array state by
+        // step_count time steps.
+        template<typename URNG>
+        void step(T* state, std::size_t count, std::size_t step_count, URNG& random)
+        {
+            for (std::size_t s = 0; s < step_count; s++) {
+                step(state, count, random);
+            }
+        }
+
+    private:
+        // update_block applies the transition to a block of states with a
+        // fixed trip count, which vectorizes at -O2.
+        void update_block(T* state, T const* noise) const
+        {
+            auto const mu = mu_;
+            auto const decay = decay_;
+            auto const scale = scale_;
+
+            for (std::size_t i = 0; i < ziggurat_detail::bulk_block_size; i++) {
+                state[i] = mu + decay * (state[i] - mu) + scale * noise[i];
+            }
+        }
+
+        T theta_;
+        T sigma_;
+        T dt_;
+        T mu_;
+        T decay_;
+        T scale_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+}
+
+#endif
@@ -0,0 +1,338 @@
+// C++20 ranges and coroutine interfaces to normal random number generation
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_RANGES_HPP
+#define INCLUDED_ZIGGURAT_RANGES_HPP
+
+#include "ziggurat.hpp"
+
+#if defined(__has_include)
+# if __has_include(<version>)
+#  include <version>
+# endif
+#endif
+
+#if defined(__cpp_lib_ranges) && defined(__cpp_concepts)
+# define ZIGGURAT_HAS_RANGES 1
+#endif
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+# define ZIGGURAT_HAS_COROUTINES 1
+#endif
+
+#if defined(ZIGGURAT_HAS_RANGES) || defined(ZIGGURAT_HAS_COROUTINES)
+# include <cstddef>
+# include <iterator>
+# include <memory>
+# include <random>
+# include <utility>
+#endif
+
+#if defined(ZIGGURAT_HAS_RANGES)
+# include <ranges>
+#endif
+
+#if defined(ZIGGURAT_HAS_COROUTINES)
+# include <coroutine>
+# include <exception>
+#endif
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // range_buffer_size is the number of numbers the lazy interfaces
+        // generate at once.
+        constexpr std::size_t range_buffer_size = 256;
+    }
+
+#if defined(ZIGGURAT_HAS_RANGES)
+    // normal_view is an infinite input view of normal random numbers drawn
+    // from a referenced engine. Numbers are generated in blocks by the bulk
+    // ziggurat kernel, so iterating is as cheap as reading an array. Use
+    // views::take to get a finite range:
+    //
+    //     for (double z : cxx::normal_view(engine) | std::views::take(n))
+    //
+    // The view buffers numbers, so the engine is advanced in blocks.
+    template<typename Engine, typename T = double>
+    class normal_view : public std::ranges::view_interface<normal_view<Engine, T>>
+    {
+    public:
+        using param_type = typename ziggurat_normal_distribution<T>::param_type;
+
+        class iterator
+        {
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator() = default;
+
+            T operator*() const
+            {
+                return view_->buffer_[view_->position_];
+            }
+
+            iterator& operator++()
+            {
+                if (++view_->position_ == ziggurat_detail::range_buffer_size) {
+                    view_->refill();
+                }
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool operator==(iterator const&, std::unreachable_sentinel_t)
+            {
+                return false;
+            }
+
+        private:
+            friend class normal_view;
+
+            explicit iterator(normal_view* view)
+                : view_{view}
+            {
+            }
+
+            normal_view* view_ = nullptr;
+        };
+
+        normal_view() = default;
+
+        // This constructor creates a view of numbers with given parameters
+        // drawn from engine. The engine must outlive the view.
+        explicit normal_view(Engine& engine, param_type const& param = param_type{})
+            : engine_{std::addressof(engine)}, normal_{param}
+        {
+        }
+
+        // begin generates the first block and returns an iterator. Since this
+        // is an input view, begin may be called only once.
+        iterator begin()
+        {
+            refill();
+            return iterator{this};
+        }
+
+        std::unreachable_sentinel_t end() const
+        {
+            return std::unreachable_sentinel;
+        }
+
+    private:
+        void refill()
+        {
+            normal_.generate(buffer_, buffer_ + ziggurat_detail::range_buffer_size, *engine_);
+            position_ = 0;
+        }
+
+        Engine* engine_ = nullptr;
+        ziggurat_normal_distribution<T> normal_;
+        std::size_t position_ = 0;
+        T buffer_[ziggurat_detail::range_buffer_size] = {};
+    };
+
+    template<typename Engine>
+    normal_view(Engine&) -> normal_view<Engine, double>;
+#endif
+
+#if defined(ZIGGURAT_HAS_COROUTINES)
+    // normal_generator is a coroutine-based input range of normal random
+    // numbers returned by generate_normals.
+    template<typename T>
+    class normal_generator
+    {
+    public:
+        struct promise_type
+        {
+            T const* value = nullptr;
+            std::exception_ptr error;
+
+            normal_generator get_return_object()
+            {
+                return normal_generator{handle_type::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always yield_value(T const& yielded) noexcept
+            {
+                value = std::addressof(yielded);
+                return {};
+            }
+
+            void return_void()
+            {
+            }
+
+            void unhandled_exception()
+            {
+                error = std::current_exception();
+            }
+        };
+
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        class iterator
+        {
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator() = default;
+
+            T operator*() const
+            {
+                return *handle_.promise().value;
+            }
+
+            iterator& operator++()
+            {
+                handle_.resume();
+                rethrow();
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool operator==(iterator const& it, std::default_sentinel_t)
+            {
+                return !it.handle_ || it.handle_.done();
+            }
+
+        private:
+            friend class normal_generator;
+
+            explicit iterator(handle_type handle)
+                : handle_{handle}
+            {
+            }
+
+            void rethrow() const
+            {
+                if (handle_.promise().error) {
+                    std::rethrow_exception(handle_.promise().error);
+                }
+            }
+
+            handle_type handle_;
+        };
+
+        normal_generator(normal_generator&& other) noexcept
+            : handle_{std::exchange(other.handle_, nullptr)}
+        {
+        }
+
+        normal_generator& operator=(normal_generator&& other) noexcept
+        {
+            if (this != &other) {
+                if (handle_) {
+                    handle_.destroy();
+                }
+                handle_ = std::exchange(other.handle_, nullptr);
+            }
+            return *this;
+        }
+
+        ~normal_generator()
+        {
+            if (handle_) {
+                handle_.destroy();
+            }
+        }
+
+        // begin starts the coroutine. It may be called only once.
+        iterator begin()
+        {
+            iterator it{handle_};
+            ++it;
+            return it;
+        }
+
+        std::default_sentinel_t end() const
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        explicit normal_generator(handle_type handle)
+            : handle_{handle}
+        {
+        }
+
+        handle_type handle_;
+    };
+
+    // generate_normals is a coroutine that yields normal random numbers drawn
+    // from engine. If count is nonzero, it stops after yielding count numbers;
+    // otherwise it yields indefinitely. Numbers are generated in blocks by the
+    // bulk ziggurat kernel. The engine must outlive the generator.
+    template<typename T = double, typename Engine>
+    normal_generator<T> generate_normals(
+        Engine& engine,
+        typename ziggurat_normal_distribution<T>::param_type param = {},
+        std::size_t count = 0
+    )
+    {
+        constexpr std::size_t buffer_size = ziggurat_detail::range_buffer_size;
+
+        ziggurat_normal_distribution<T> normal{param};
+        T buffer[buffer_size];
+
+        for (std::size_t yielded = 0; count == 0 || yielded < count; ) {
+            normal.generate(buffer, buffer + buffer_size, engine);
+
+            for (std::size_t i = 0; i < buffer_size && (count == 0 || yielded < count); i++) {
+                co_yield buffer[i];
+                yielded++;
+            }
+        }
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,309 @@
+// Uniformly random unit vectors on the n-sphere
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_SPHERE_HPP
+#define INCLUDED_ZIGGURAT_SPHERE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "ziggurat.hpp"
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // rsqrt_traits holds the constants of rsqrt_kernel for a
+        // floating-point type: the integer type of the same size, the magic
+        // number giving an initial approximation of 1/sqrt(x) with a relative
+        // error below 3.5% and the number of Newton steps that bring the
+        // error below the machine epsilon.
+        template<typename T>
+        struct rsqrt_traits;
+
+        template<>
+        struct rsqrt_traits<double>
+        {
+            using bits_type = std::uint64_t;
+
+            static constexpr std::uint64_t magic = 0x5FE6EB50C7B537A9;
+            static constexpr int newton_steps = 4;
+        };
+
+        template<>
+        struct rsqrt_traits<float>
+        {
+            using bits_type = std::uint32_t;
+
+            static constexpr std::uint32_t magic = 0x5F375A86;
+            static constexpr int newton_steps = 3;
+        };
+
+        // rsqrt_kernel replaces each of the bulk_block_size positive numbers
+        // at data by its reciprocal square root. The loop is branch-free,
+        // uses no library calls and has a fixed trip count, so the compiler
+        // vectorizes it even at -O2.
+        template<typename T>
+        void rsqrt_kernel(T* data)
+        {
+            using traits = rsqrt_traits<T>;
+            using bits_type = typename traits::bits_type;
+
+            constexpr std::size_t size = bulk_block_size;
+
+            for (std::size_t i = 0; i < size; i++) {
+                auto const x = data[i];
+
+                bits_type bits;
+                std::memcpy(&bits, &x, sizeof x);
+                bits = traits::magic - (bits >> 1);
+                T y;
+                std::memcpy(&y, &bits, sizeof y);
+
+                auto const half_x = x / 2;
+                for (int step = 0; step < traits::newton_steps; step++) {
+                    y = y * (T(1.5) - half_x * y * y);
+                }
+
+                data[i] = y;
+            }
+        }
+    }
+
+    // vector_layout selects the memory layout of a batch of vectors. With
+    // interleaved (array of structures), the coordinates of a vector are
+    // contiguous: the d-th coordinate of the k-th vector is at
+    // k * dimension + d. With planar (structure of arrays), each coordinate
+    // of all vectors is contiguous: the same coordinate is at d * count + k.
+    enum class vector_layout
+    {
+        interleaved,
+        planar
+    };
+
+    // unit_vector_generator generates random unit vectors uniformly
+    // distributed on the sphere in any dimension. Vectors are generated in
+    // blocks with branch-free, vectorized loops:
+    //
+    // - In 2D and 3D, points uniform in the unit disk are drawn by rejection
+    //   from the square and mapped to the circle (von Neumann 1951) or the
+    //   sphere (Marsaglia 1972). This needs fewer random bits than normal
+    //   numbers do.
+    // - In higher dimensions, vectors of standard normal numbers drawn by
+    //   the bulk ziggurat kernel are normalized with a reciprocal square
+    //   root refined by Newton steps.
+    template<typename T>
+    class unit_vector_generator
+    {
+    public:
+        // This constructor creates a generator of unit vectors of given
+        // dimension (2 for the circle, 3 for the sphere) stored in given
+        // layout.
+        explicit unit_vector_generator(
+            std::size_t dimension,
+            vector_layout layout = vector_layout::interleaved
+        )
+            : dimension_{dimension}
+            , layout_{layout}
+            , normals_(std::max<std::size_t>(dimension, 3) * ziggurat_detail::bulk_block_size)
+        {
+        }
+
+        // dimension returns the dimension of generated vectors.
+        std::size_t dimension() const
+        {
+            return dimension_;
+        }
+
+        // layout returns the memory layout of generated vectors.
+        vector_layout layout() const
+        {
+            return layout_;
+        }
+
+        // generate writes count unit vectors to the array out, which must
+        // have room for count * dimension() numbers.
+        template<typename URNG>
+        void generate(T* out, std::size_t count, URNG& random)
+        {
+            if (dimension_ == 2 || dimension_ == 3) {
+                generate_from_disk(out, count, random);
+            } else {
+                generate_from_normals(out, count, random);
+            }
+        }
+
+    private:
+        template<typename URNG>
+        void generate_from_disk(T* out, std::size_t count, URNG& random)
+        {
+            constexpr std::size_t block = ziggurat_detail::bulk_block_size;
+
+            auto const n = dimension_;
+            auto const x = normals_.data();
+            auto const y = x + block;
+            auto const z = y + block;
+
+            T u[block];
+            T v[block];
+            T s[block];
+            T w[block];
+
+            // A single engine invocation feeds both coordinates if it
+            // provides enough bits, e.g. float with a 64-bit engine.
+            constexpr std::size_t bit_count = ziggurat_detail::engine_bits<URNG>();
+            constexpr std::size_t real_bits = std::numeric_limits<T>::digits;
+            constexpr bool split_bits = (bit_count >= 2 * real_bits);
+            constexpr std::uint64_t low_mask = (std::uint64_t(1) << real_bits) - 1;
+
+            for (std::size_t done = 0; done < count; ) {
+                for (std::size_t k = 0; k < block; k++) {
+                    if (split_bits) {
+                        auto const bits = ziggurat_detail::generate_bits<bit_count>(random);
+                        u[k] = 2 * ziggurat_detail::canonicalize<bit_count, T>(bits) - 1;
+                        v[k] = 2 * ziggurat_detail::canonicalize<real_bits, T>(bits & low_mask) - 1;
+                    } else {
+                        u[k] = 2 * ziggurat_detail::generate_uniform<T>(random) - 1;
+                        v[k] = 2 * ziggurat_detail::generate_uniform<T>(random) - 1;
+                    }
+                }
+
+                for (std::size_t k = 0; k < block; k++) {
+                    s[k] = u[k] * u[k] + v[k] * v[k];
+                }
+
+                if (n == 2) {
+                    // (u + iv)^2 / |u + iv|^2 is uniform on the circle.
+                    for (std::size_t k = 0; k < block; k++) {
+                        auto const inv_s = 1 / (s[k] > 0 ? s[k] : T(1));
+                        x[k] = (u[k] * u[k] - v[k] * v[k]) * inv_s;
+                        y[k] = 2 * u[k] * v[k] * inv_s;
+                    }
+                } else {
+                    for (std::size_t k = 0; k < block; k++) {
+                        w[k] = (s[k] < 1 ? 1 - s[k] : T(1));
+                    }
+                    std::copy(w, w + block, z);
+                    ziggurat_detail::rsqrt_kernel(z);
+
+                    // 2 sqrt(1 - s) (u, v) and 1 - 2s.
+                    for (std::size_t k = 0; k < block; k++) {
+                        auto const scale = 2 * w[k] * z[k];
+                        x[k] = u[k] * scale;
+                        y[k] = v[k] * scale;
+                        z[k] = 1 - 2 * s[k];
+                    }
+                }
+
+                // Compact the accepted points to the front of the block. The
+                // loop is branch-free since a fifth of the points is rejected
+                // at random.
+                std::size_t accepted = 0;
+                for (std::size_t k = 0; k < block; k++) {
+                    x[accepted] = x[k];
+                    y[accepted] = y[k];
+                    z[accepted] = z[k];
+                    accepted += (s[k] < 1 && s[k] > 0);
+                }
+
+                auto const cols = std::min(accepted, count - done);
+                emit(out, count, done, cols);
+                done += cols;
+            }
+        }
+
+        template<typename URNG>
+        void generate_from_normals(T* out, std::size_t count, URNG& random)
+        {
+            constexpr std::size_t block = ziggurat_detail::bulk_block_size;
+
+            auto const n = dimension_;
+            auto const z = normals_.data();
+
+            for (std::size_t done = 0; done < count; done += block) {
+                auto const cols = std::min(block, count - done);
+
+                normal_.generate(z, z + n * block, random);
+
+                T scales[block] = {};
+                for (std::size_t d = 0; d < n; d++) {
+                    auto const z_row = z + d * block;
+                    for (std::size_t k = 0; k < block; k++) {
+                        scales[k] += z_row[k] * z_row[k];
+                    }
+                }
+                ziggurat_detail::rsqrt_kernel(scales);
+
+                for (std::size_t d = 0; d < n; d++) {
+                    auto const z_row = z + d * block;
+                    for (std::size_t k = 0; k < block; k++) {
+                        z_row[k] *= scales[k];
+                    }
+                }
+
+                emit(out, count, done, cols);
+            }
+        }
+
+        // emit copies the first cols vectors of the dimension-major block of
+        // vectors in normals_ to the output as vectors done, done + 1, ... of
+        // count vectors.
+        void emit(T* out, std::size_t count, std::size_t done, std::size_t cols) const
+        {
+            constexpr std::size_t stride = ziggurat_detail::bulk_block_size;
+
+            auto const n = dimension_;
+            auto const z = normals_.data();
+
+            if (layout_ == vector_layout::planar) {
+                for (std::size_t d = 0; d < n; d++) {
+                    auto const z_row = z + d * stride;
+                    std::copy(z_row, z_row + cols, out + d * count + done);
+                }
+            } else {
+                auto const dest = out + done * n;
+                for (std::size_t k = 0; k < cols; k++) {
+                    for (std::size_t d = 0; d < n; d++) {
+                        dest[k * n + d] = z[d * stride + k];
+                    }
+                }
+            }
+        }
+
+        std::size_t dimension_;
+        vector_layout layout_;
+        std::vector<T> normals_;
+        ziggurat_normal_distribution<T> normal_;
+    };
+}
+
+#endif
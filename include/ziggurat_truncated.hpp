@@ -0,0 +1,542 @@
+// Truncated normal distribution driven by the ziggurat normal distribution
+
+// Copyright snsinfu 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef INCLUDED_ZIGGURAT_TRUNCATED_HPP
+#define INCLUDED_ZIGGURAT_TRUNCATED_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+#include "ziggurat.hpp"
+
+
+namespace cxx
+{
+    namespace ziggurat_detail
+    {
+        // truncated_half_normal_limit is the largest lower bound of a
+        // one-sided standardized interval [a, b) with a >= 0 for which the
+        // rejection from absolute ziggurat normals is faster than the
+        // exponential proposal of Robert (1995). The exponential proposal
+        // needs a logarithm per candidate, which outweighs the rejection rate
+        // of absolute normals until about 0.55.
+        constexpr double truncated_half_normal_limit = 0.55;
+
+        // truncated_normal_sampler samples standard normal random numbers
+        // truncated to an interval [lower, upper]. The strategy is chosen per
+        // interval following Robert (1995):
+        //
+        // - An interval containing zero is sampled by rejecting ziggurat
+        //   normals if it is wide, or by uniform proposals if it is narrower
+        //   than sqrt(2 pi).
+        // - A one-sided interval [a, b] with a >= 0 is sampled by uniform
+        //   proposals if it is narrow, by rejecting absolute ziggurat normals
+        //   if a is small, and otherwise by exponential proposals with the
+        //   optimal rate.
+        //
+        // An interval on the negative side is mirrored to the positive side.
+        template<typename T>
+        class truncated_normal_sampler
+        {
+        public:
+            truncated_normal_sampler(T lower, T upper)
+                : sign_{upper <= 0 ? T(-1) : T(1)}
+                , lower_{upper <= 0 ? -upper : lower}
+                , upper_{upper <= 0 ? -lower : upper}
+            {
+                T const sqrt_2pi = T(2.5066282746310002);
+
+                if (lower_ < 0) {
+                    method_ = (upper_ - lower_ < sqrt_2pi ? method::uniform : method::normal);
+                    return;
+                }
+
+                // The uniform proposal is better than the exponential one
+                // when the interval is narrower than this width.
+                auto const root = std::sqrt(lower_ * lower_ + 4);
+                auto const uniform_width =
+                    2 * std::sqrt(T(2.718281828459045)) / (lower_ + root)
+                    * std::exp((lower_ * lower_ - lower_ * root) / 4);
+
+                if (upper_ - lower_ <= uniform_width) {
+                    method_ = method::uniform;
+                    log_peak_ = lower_ * lower_ / 2;
+                } else if (lower_ < T(truncated_half_normal_limit)) {
+                    method_ = method::half_normal;
+                } else {
+                    method_ = method::exponential;
+                    rate_ = (lower_ + root) / 2;
+                }
+            }
+
+            // operator() returns a truncated normal random number.
+            template<typename URNG>
+            inline T operator()(URNG& random)
+            {
+                return sign_ * sample(random);
+            }
+
+            // generate fills the range [first, last) with truncated normal
+            // random numbers scaled by stddev and shifted by mean. The
+            // rejection strategies draw candidates from the bulk ziggurat
+            // kernel and keep the ones falling in the interval.
+            template<typename ForwardIterator, typename URNG>
+            void generate(
+                ForwardIterator first,
+                ForwardIterator last,
+                URNG& random,
+                T mean,
+                T stddev
+            )
+            {
+                auto const scale = sign_ * stddev;
+
+                if (method_ != method::normal && method_ != method::half_normal) {
+                    for (; first != last; ++first) {
+                        *first = mean + scale * sample(random);
+                    }
+                    return;
+                }
+
+                bool const absolute = (method_ == method::half_normal);
+                T normals[bulk_block_size];
+
+                while (first != last) {
+                    normal_.generate(normals, normals + bulk_block_size, random);
+
+                    for (std::size_t i = 0; i < bulk_block_size; i++) {
+                        auto const z = absolute ? std::fabs(normals[i]) : normals[i];
+                        if (z < lower_ || z > upper_) {
+                            continue;
+                        }
+                        *first = mean + scale * z;
+                        if (++first == last) {
+                            return;
+                        }
+                    }
+                }
+            }
+
+        private:
+            enum class method
+            {
+                normal,
+                half_normal,
+                uniform,
+                exponential
+            };
+
+            template<typename URNG>
+            inline T sample(URNG& random)
+            {
+                switch (method_) {
+                case method::normal:
+                    return sample_normal(random);
+
+                case method::half_normal:
+                    return sample_half_normal(random);
+
+                case method::uniform:
+                    return sample_uniform(random);
+
+                case method::exponential:
+                    return sample_exponential(random);
+                }
+                return 0;
+            }
+
+            template<typename URNG>
+            inline T sample_normal(URNG& random)
+            {
+                for (;;) {
+                    auto const z = normal_(random);
+                    if (z >= lower_ && z <= upper_) {
+                        return z;
+                    }
+                }
+            }
+
+            template<typename URNG>
+            inline T sample_half_normal(URNG& random)
+            {
+                for (;;) {
+                    auto const z = std::fabs(normal_(random));
+                    if (z >= lower_ && z <= upper_) {
+                        return z;
+                    }
+                }
+            }
+
+            // The proposal is uniform on the interval and accepted with the
+            // probability exp(-z^2/2) relative to its peak on the interval.
+            // The bound exp(-q) >= 1 - q accepts most candidates without exp.
+            template<typename URNG>
+            inline T sample_uniform(URNG& random)
+            {
+                auto const width = upper_ - lower_;
+
+                for (;;) {
+                    auto const z = lower_ + width * generate_uniform<T>(random);
+                    auto const u = generate_uniform<T>(random);
+                    auto const q = z * z / 2 - log_peak_;
+                    if (u <= 1 - q || u <= std::exp(-q)) {
+                        return z;
+                    }
+                }
+            }
+
+            // The proposal is a shifted exponential a + E / rate, which is
+            // accepted with the probability exp(-(z - rate)^2 / 2). The bound
+            // exp(-q) >= 1 - q accepts most candidates without exp.
+            template<typename URNG>
+            inline T sample_exponential(URNG& random)
+            {
+                for (;;) {
+                    auto const z = lower_ - std::log(1 - generate_uniform<T>(random)) / rate_;
+                    if (z > upper_) {
+                        continue;
+                    }
+                    auto const u = generate_uniform<T>(random);
+                    auto const d = z - rate_;
+                    auto const q = d * d / 2;
+                    if (u <= 1 - q || u <= std::exp(-q)) {
+                        return z;
+                    }
+                }
+            }
+
+            T sign_;
+            T lower_;
+            T upper_;
+            method method_ = method::normal;
+            T log_peak_ = 0;
+            T rate_ = 1;
+            ziggurat_normal_distribution<T> normal_;
+        };
+    }
+
+    // ziggurat_truncated_normal_distribution generates normal random numbers
+    // with given mean and standard deviation truncated to an interval [a, b].
+    // The sampling strategy is chosen for each interval so that numbers are
+    // generated efficiently even far in the tails. The bounds may be
+    // infinite, and a must be less than b.
+    template<typename T>
+    class ziggurat_truncated_normal_distribution
+    {
+    public:
+        // result_type is an alias of T.
+        using result_type = T;
+
+        // param_type holds distribution parameters.
+        struct param_type
+        {
+            using distribution_type = ziggurat_truncated_normal_distribution;
+
+            // Default constructor initializes mean to 0, stddev to 1 and the
+            // bounds to -infinity and +infinity.
+            param_type() = default;
+
+            // This constructor initializes the mean, the standard deviation
+            // and the bounds to given values.
+            param_type(
+                result_type mean,
+                result_type stddev,
+                result_type a,
+                result_type b
+            )
+                : mean_{mean}, stddev_{stddev}, a_{a}, b_{b}
+            {
+            }
+
+            // mean returns the mean parameter.
+            inline result_type mean() const
+            {
+                return mean_;
+            }
+
+            // stddev returns the standard deviation parameter.
+            inline result_type stddev() const
+            {
+                return stddev_;
+            }
+
+            // a returns the lower bound.
+            inline result_type a() const
+            {
+                return a_;
+            }
+
+            // b returns the upper bound.
+            inline result_type b() const
+            {
+                return b_;
+            }
+
+            friend bool operator==(param_type const& p1, param_type const& p2)
+            {
+                return p1.mean_ == p2.mean_ && p1.stddev_ == p2.stddev_
+                    && p1.a_ == p2.a_ && p1.b_ == p2.b_;
+            }
+
+            friend bool operator!=(param_type const& p1, param_type const& p2)
+            {
+                return !(p1 == p2);
+            }
+
+            // Stream output writes mean, stddev, a and b to a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_ostream<Char, Tr>& operator<<(
+                std::basic_ostream<Char, Tr>& os,
+                param_type const& param
+            )
+            {
+                using sentry_type = typename std::basic_ostream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{os}) {
+                    Char const space = os.widen(' ');
+                    os << param.mean_ << space << param.stddev_ << space
+                       << param.a_ << space << param.b_;
+                }
+
+                return os;
+            }
+
+            // Stream input reads mean, stddev, a and b from a stream.
+            template<typename Char, typename Tr>
+            friend std::basic_istream<Char, Tr>& operator>>(
+                std::basic_istream<Char, Tr>& is,
+                param_type& param
+            )
+            {
+                using sentry_type = typename std::basic_istream<Char, Tr>::sentry;
+
+                if (sentry_type sentry{is}) {
+                    param_type tmp;
+                    if (is >> tmp.mean_ >> tmp.stddev_ >> tmp.a_ >> tmp.b_) {
+                        param = tmp;
+                    }
+                }
+
+                return is;
+            }
+
+        private:
+            result_type mean_ = 0;
+            result_type stddev_ = 1;
+            result_type a_ = -std::numeric_limits<result_type>::infinity();
+            result_type b_ = std::numeric_limits<result_type>::infinity();
+        };
+
+        // Default constructor creates an untruncated standard normal
+        // distribution.
+        ziggurat_truncated_normal_distribution()
+            : ziggurat_truncated_normal_distribution{param_type{}}
+        {
+        }
+
+        // This constructor creates a normal distribution with given mean and
+        // standard deviation truncated to [a, b].
+        ziggurat_truncated_normal_distribution(
+            result_type mean,
+            result_type stddev,
+            result_type a,
+            result_type b
+        )
+            : ziggurat_truncated_normal_distribution{param_type{mean, stddev, a, b}}
+        {
+        }
+
+        // This constructor creates a truncated normal distribution having
+        // given parameters.
+        explicit ziggurat_truncated_normal_distribution(param_type const& param)
+            : param_{param}, sampler_{make_sampler(param)}
+        {
+        }
+
+        // reset does nothing; this is a RandomNumberDistribution requirement.
+        void reset()
+        {
+        }
+
+        // Invoking a distribution with a random number engine returns a newly
+        // generated truncated normal random number with the preconfigured
+        // parameters.
+        template<typename URNG>
+        inline T operator()(URNG& random)
+        {
+            return param_.mean() + param_.stddev() * sampler_(random);
+        }
+
+        // Invoking a distribution with a random number engine and a parameter
+        // object returns a newly generated truncated normal random number
+        // with given parameters. The strategy is chosen for the interval on
+        // each call, which costs a square root and an exponential.
+        template<typename URNG>
+        inline T operator()(URNG& random, param_type const& param)
+        {
+            auto sampler = make_sampler(param);
+            return param.mean() + param.stddev() * sampler(random);
+        }
+
+        // generate fills the range [first, last) with truncated normal
+        // random numbers with the preconfigured parameters. The generated
+        // sequence differs from the one generated by repeated operator()
+        // calls.
+        template<typename ForwardIterator, typename URNG>
+        void generate(ForwardIterator first, ForwardIterator last, URNG& random)
+        {
+            sampler_.generate(first, last, random, param_.mean(), param_.stddev());
+        }
+
+        // generate fills the range [first, last) with truncated normal
+        // random numbers with given parameters.
+        template<typename ForwardIterator, typename URNG>
+        void generate(
+            ForwardIterator first,
+            ForwardIterator last,
+            URNG& random,
+            param_type const& param
+        )
+        {
+            auto sampler = make_sampler(param);
+            sampler.generate(first, last, random, param.mean(), param.stddev());
+        }
+
+        // mean returns the mean parameter of this distribution.
+        result_type mean() const
+        {
+            return param_.mean();
+        }
+
+        // stddev returns the standard deviation parameter of this
+        // distribution.
+        result_type stddev() const
+        {
+            return param_.stddev();
+        }
+
+        // a returns the lower bound of this distribution.
+        result_type a() const
+        {
+            return param_.a();
+        }
+
+        // b returns the upper bound of this distribution.
+        result_type b() const
+        {
+            return param_.b();
+        }
+
+        // param returns the parameters of this distribution as a param_type.
+        param_type param() const
+        {
+            return param_;
+        }
+
+        // param sets the parameters of this distribution.
+        void param(param_type const& param)
+        {
+            param_ = param;
+            sampler_ = make_sampler(param);
+        }
+
+        // min returns the lower bound a.
+        result_type min() const
+        {
+            return param_.a();
+        }
+
+        // max returns the upper bound b.
+        result_type max() const
+        {
+            return param_.b();
+        }
+
+    private:
+        static ziggurat_detail::truncated_normal_sampler<T> make_sampler(param_type const& param)
+        {
+            return ziggurat_detail::truncated_normal_sampler<T>{
+                (param.a() - param.mean()) / param.stddev(),
+                (param.b() - param.mean()) / param.stddev()
+            };
+        }
+
+        param_type param_;
+        ziggurat_detail::truncated_normal_sampler<T> sampler_;
+    };
+
+    // Equality comparison d1 == d2 compares the equality of distribution
+    // parameters.
+    template<typename T>
+    bool operator==(
+        ziggurat_truncated_normal_distribution<T> const& d1,
+        ziggurat_truncated_normal_distribution<T> const& d2
+    )
+    {
+        return d1.param() == d2.param();
+    }
+
+    // Inequality comparison d1 != d2 compares the inequality of distribution
+    // parameters.
+    template<typename T>
+    bool operator!=(
+        ziggurat_truncated_normal_distribution<T> const& d1,
+        ziggurat_truncated_normal_distribution<T> const& d2
+    )
+    {
+        return !(d1 == d2);
+    }
+
+    // Stream output writes the parameters of a distribution to a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_ostream<Char, Tr>& operator<<(
+        std::basic_ostream<Char, Tr>& os,
+        ziggurat_truncated_normal_distribution<T> const& dist
+    )
+    {
+        return os << dist.param();
+    }
+
+    // Stream input reads the parameters of a distribution from a stream.
+    template<typename Char, typename Tr, typename T>
+    std::basic_istream<Char, Tr>& operator>>(
+        std::basic_istream<Char, Tr>& is,
+        ziggurat_truncated_normal_distribution<T>& dist
+    )
+    {
+        typename ziggurat_truncated_normal_distribution<T>::param_type param;
+        if (is >> param) {
+            dist.param(param);
+        }
+        return is;
+    }
+}
+
+#endif
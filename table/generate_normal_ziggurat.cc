@@ -1,10 +1,12 @@
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <random>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 
 namespace
@@ -86,12 +88,17 @@ namespace
     }
 }
 
-int main()
+// Usage: generate_normal_ziggurat [table_bits]
+//
+// The default 7 bits generates the 128-layer table of the normal distribution.
+// The sign bit is not needed for the half-normal distribution, so its table is
+// generated with 8 bits.
+int main(int argc, char** argv)
 {
-    constexpr int table_bits = 7;
-    constexpr int strip_count = (1 << table_bits) + 1;
+    int const table_bits = (argc > 1 ? std::atoi(argv[1]) : 7);
+    std::size_t const strip_count = (std::size_t(1) << table_bits) + 1;
 
-    double table[strip_count] = {};
+    std::vector<double> table(strip_count);
 
     // Build the table of strip edges.
 
@@ -104,7 +111,7 @@ int main()
         auto const upper_bound = density(0);
         auto current_top = density(edge);
 
-        for (int i = 1; i < strip_count - 1; i++) {
+        for (std::size_t i = 1; i < strip_count - 1; i++) {
             current_top += strip_area / table[i];
             if (current_top > upper_bound) {
                 return false;
@@ -132,7 +139,7 @@ int main()
 
     build_table(roots.second);
 
-    for (int i = 0; i < strip_count; i++) {
+    for (std::size_t i = 0; i < strip_count; i++) {
         if (i > 0 && i % 4 == 0) {
             std::cout << '\n';
         }
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_bank.hpp>
+#include <ziggurat_parallel.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    // temporary_file removes the file at a path on destruction.
+    struct temporary_file
+    {
+        std::string path;
+
+        explicit temporary_file(std::string const& p)
+            : path{p}
+        {
+        }
+
+        ~temporary_file()
+        {
+            std::remove(path.c_str());
+        }
+    };
+}
+
+TEST_CASE("noise_bank - reads numbers written by write_noise_bank")
+{
+    temporary_file const file{"test_noise_bank_double.tmp"};
+    std::uint64_t const count = 50000;
+
+    cxx::write_noise_bank<double>(file.path, count, 123);
+
+    std::vector<double> expected(count);
+    cxx::parallel_generate(expected.begin(), expected.end(), 123);
+
+    cxx::noise_bank<double> const bank{file.path};
+    CHECK(bank.size() == count);
+    CHECK(bank.seed() == 123);
+    CHECK(bank.engine() == "mt19937_64");
+    CHECK(bank.table_version() == cxx::ziggurat_detail::table_version);
+
+    auto const all = bank.all();
+    CHECK(std::vector<double>(all.begin(), all.end()) == expected);
+
+    auto const span = bank.subspan(1000, 24);
+    CHECK(span.size() == 24);
+    CHECK(span[0] == expected[1000]);
+    CHECK(span[23] == expected[1023]);
+}
+
+TEST_CASE("noise_bank - data is aligned")
+{
+    temporary_file const file{"test_noise_bank_float.tmp"};
+
+    cxx::write_noise_bank<float, std::mt19937>(file.path, 1000, 42);
+
+    cxx::noise_bank<float> const bank{file.path};
+    CHECK(bank.engine() == "mt19937");
+    CHECK(reinterpret_cast<std::uintptr_t>(bank.data()) % 64 == 0);
+}
+
+TEST_CASE("noise_bank - rejects mismatching value type")
+{
+    temporary_file const file{"test_noise_bank_type.tmp"};
+
+    cxx::write_noise_bank<float>(file.path, 100, 1);
+
+    CHECK_THROWS_AS(cxx::noise_bank<double>{file.path}, std::runtime_error);
+}
+
+TEST_CASE("noise_bank - rejects non-bank file")
+{
+    temporary_file const file{"test_noise_bank_invalid.tmp"};
+    std::ofstream{file.path} << std::string(8192, 'x');
+
+    CHECK_THROWS_AS(cxx::noise_bank<double>{file.path}, std::runtime_error);
+    CHECK_THROWS_AS(cxx::noise_bank<double>{"nonexistent.tmp"}, std::system_error);
+}
+
+TEST_CASE("write_noise_bank - rejects too large count")
+{
+    temporary_file const file{"test_noise_bank_large.tmp"};
+    std::uint64_t const count = std::numeric_limits<std::uint64_t>::max() / 8 + 1;
+
+    CHECK_THROWS_AS(cxx::write_noise_bank<double>(file.path, count, 1), std::length_error);
+    CHECK_FALSE(std::ifstream{file.path}.is_open());
+}
+
+TEST_CASE("noise_bank::subspan - checks range")
+{
+    temporary_file const file{"test_noise_bank_range.tmp"};
+
+    cxx::write_noise_bank<double>(file.path, 100, 1);
+
+    cxx::noise_bank<double> const bank{file.path};
+    CHECK(bank.subspan(100, 0).size() == 0);
+    CHECK_THROWS_AS(bank.subspan(50, 51), std::out_of_range);
+    CHECK_THROWS_AS(bank.subspan(101, 0), std::out_of_range);
+}
@@ -0,0 +1,240 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_buffer.hpp>
+
+#include <catch.hpp>
+
+
+TEST_CASE("prefetch_normal_source - generates normal numbers")
+{
+    // Small capacity exercises wrap-around and waiting.
+    cxx::prefetch_normal_source<double> source{123, {}, 100};
+
+    constexpr int sample_count = 20000;
+    double mean = 0;
+    double var = 0;
+
+    for (int i = 0; i < sample_count; i++) {
+        double const x = source();
+        mean += x;
+        var += x * x;
+    }
+    mean /= sample_count;
+    var /= sample_count;
+
+    CHECK(mean == Approx(0).margin(0.05));
+    CHECK(var == Approx(1).epsilon(0.05));
+}
+
+TEST_CASE("prefetch_normal_source - is deterministic for given seed")
+{
+    cxx::prefetch_normal_source<float> source_1{42, {}, 64};
+    cxx::prefetch_normal_source<float> source_2{42, {}, 1024};
+
+    for (int i = 0; i < 10000; i++) {
+        CHECK(source_1() == source_2());
+    }
+}
+
+TEST_CASE("prefetch_normal_source - applies parameters")
+{
+    cxx::prefetch_normal_source<double>::param_type param{5.6, 0.1};
+    cxx::prefetch_normal_source<double> source{1, param};
+
+    CHECK(source.mean() == 5.6);
+    CHECK(source.stddev() == 0.1);
+    CHECK(source.param() == param);
+
+    constexpr int sample_count = 1000;
+    double mean = 0;
+
+    for (int i = 0; i < sample_count; i++) {
+        mean += source();
+    }
+    mean /= sample_count;
+
+    CHECK(mean == Approx(5.6).margin(0.01));
+}
+
+TEST_CASE("prefetch_normal_source - is destructible without consuming")
+{
+    cxx::prefetch_normal_source<double> source{1};
+}
+
+TEST_CASE("normal_block_queue - supplies blocks of normal numbers")
+{
+    cxx::normal_block_queue<double> queue{123, 2, 1000, 4};
+
+    // Rounded up to a multiple of the bulk block size.
+    CHECK(queue.block_size() == 1024);
+
+    double mean = 0;
+    double var = 0;
+    std::size_t count = 0;
+
+    for (int i = 0; i < 16; i++) {
+        auto const block = queue.pop();
+        CHECK(block.size() == queue.block_size());
+
+        for (double x : block) {
+            mean += x;
+            var += x * x;
+            count++;
+        }
+    }
+    mean /= double(count);
+    var /= double(count);
+
+    CHECK(mean == Approx(0).margin(0.05));
+    CHECK(var == Approx(1).epsilon(0.05));
+}
+
+TEST_CASE("normal_block_queue - block content is determined by sequence number")
+{
+    using engine_type = std::mt19937_64;
+    using record = std::pair<std::uint64_t, std::vector<float>>;
+
+    cxx::normal_block_queue<float, engine_type> queue{42, 3, 256, 8};
+
+    auto consume = [&](std::vector<record>& records) {
+        for (int i = 0; i < 16; i++) {
+            auto const block = queue.pop();
+            records.emplace_back(
+                block.sequence(), std::vector<float>(block.begin(), block.end())
+            );
+        }
+    };
+
+    std::vector<record> records_1;
+    std::vector<record> records_2;
+
+    std::thread consumer{consume, std::ref(records_1)};
+    consume(records_2);
+    consumer.join();
+
+    std::vector<record> records;
+    records.insert(records.end(), records_1.begin(), records_1.end());
+    records.insert(records.end(), records_2.begin(), records_2.end());
+
+    for (auto const& rec : records) {
+        std::vector<float> expected(rec.second.size());
+        engine_type engine{cxx::ziggurat_detail::stream_seed(42, rec.first)};
+        cxx::ziggurat_normal_distribution<float> normal;
+        normal.generate(expected.begin(), expected.end(), engine);
+
+        CHECK(rec.second == expected);
+    }
+}
+
+TEST_CASE("normal_block_queue::try_pop - moves block to handle")
+{
+    cxx::normal_block_queue<double> queue{1, 1, 128, 2};
+    cxx::normal_block_queue<double>::block block;
+
+    CHECK(block.size() == 0);
+    CHECK(block.data() == nullptr);
+    CHECK(block.begin() == block.end());
+
+    while (!queue.try_pop(block)) {
+        std::this_thread::yield();
+    }
+    CHECK(block.size() == 128);
+
+    auto moved = std::move(block);
+    CHECK(moved.size() == 128);
+    CHECK(block.size() == 0);
+    CHECK(block.begin() == block.end());
+}
+
+TEST_CASE("buffered_normal_source - generates normal numbers")
+{
+    cxx::buffered_normal_source<double> source;
+
+    constexpr int sample_count = 10000;
+    double mean = 0;
+    double var = 0;
+
+    for (int i = 0; i < sample_count; i++) {
+        double const x = source();
+        mean += x;
+        var += x * x;
+    }
+    mean /= sample_count;
+    var /= sample_count;
+
+    CHECK(mean == Approx(0).margin(0.05));
+    CHECK(var == Approx(1).epsilon(0.05));
+}
+
+TEST_CASE("buffered_normal_source - is equivalent to bulk generation")
+{
+    std::mt19937_64 engine{42};
+    cxx::ziggurat_normal_distribution<double> normal{1.2, 3.4};
+    cxx::buffered_normal_source<double> source{engine, normal.param()};
+
+    std::vector<double> expected(1024);
+    normal.generate(expected.begin(), expected.end(), engine);
+
+    for (double x : expected) {
+        CHECK(source() == x);
+    }
+}
+
+TEST_CASE("buffered_normal_source::reset - discards buffered numbers")
+{
+    cxx::buffered_normal_source<float> source;
+
+    source();
+    CHECK(source.available() == source.buffer_size - 1);
+
+    auto engine = source.engine();
+    source.reset();
+    CHECK(source.available() == 0);
+
+    cxx::buffered_normal_source<float> fresh{engine};
+    CHECK(source() == fresh());
+}
+
+TEST_CASE("buffered_normal_source - is serializable with unread numbers")
+{
+    cxx::buffered_normal_source<double>::param_type param{1.2, 3.4};
+    cxx::buffered_normal_source<double> source_1{std::mt19937_64{1}, param};
+    cxx::buffered_normal_source<double> source_2;
+
+    for (int i = 0; i < 100; i++) {
+        source_1();
+    }
+
+    std::stringstream stream;
+    stream << source_1;
+    stream >> source_2;
+
+    CHECK(source_2 == source_1);
+
+    for (int i = 0; i < 1000; i++) {
+        CHECK(source_1() == source_2());
+    }
+}
+
+TEST_CASE("buffered_normal_source - is unchanged upon deserialization failure")
+{
+    cxx::buffered_normal_source<double> source;
+    source();
+
+    auto const saved = source;
+
+    std::istringstream in{"abc"};
+    bool const ok = bool(in >> source);
+
+    CHECK_FALSE(ok);
+    CHECK(source == saved);
+}
@@ -0,0 +1,175 @@
+#include <complex>
+#include <cstddef>
+#include <deque>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <ziggurat_complex.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    struct complex_moments
+    {
+        std::complex<double> mean;
+        double real_variance;
+        double imag_variance;
+        double covariance;
+    };
+
+    template<typename Container>
+    complex_moments compute_moments(Container const& samples)
+    {
+        complex_moments moments = {};
+        auto const n = double(samples.size());
+
+        for (auto const& z : samples) {
+            moments.mean += std::complex<double>(z);
+        }
+        moments.mean /= n;
+
+        for (auto const& z : samples) {
+            auto const d = std::complex<double>(z) - moments.mean;
+            moments.real_variance += d.real() * d.real();
+            moments.imag_variance += d.imag() * d.imag();
+            moments.covariance += d.real() * d.imag();
+        }
+        moments.real_variance /= n;
+        moments.imag_variance /= n;
+        moments.covariance /= n;
+
+        return moments;
+    }
+}
+
+TEST_CASE("ziggurat_complex_normal_distribution - holds parameters")
+{
+    cxx::ziggurat_complex_normal_distribution<double> const default_dist;
+    CHECK(default_dist.mean() == std::complex<double>{});
+    CHECK(default_dist.variance() == 1);
+
+    cxx::ziggurat_complex_normal_distribution<double> dist{{1, -2}, 3};
+    CHECK(dist.mean() == std::complex<double>(1, -2));
+    CHECK(dist.variance() == 3);
+    CHECK(dist != default_dist);
+
+    dist.param(default_dist.param());
+    CHECK(dist == default_dist);
+}
+
+TEST_CASE("ziggurat_complex_normal_distribution - generates circularly-symmetric numbers")
+{
+    constexpr std::size_t sample_count = 100000;
+    std::complex<double> const mean{0.5, -1};
+    double const variance = 2;
+
+    std::mt19937_64 random;
+    cxx::ziggurat_complex_normal_distribution<double> dist{mean, variance};
+
+    auto check_moments = [&](complex_moments const& moments) {
+        CHECK(moments.mean.real() == Approx(mean.real()).margin(0.01));
+        CHECK(moments.mean.imag() == Approx(mean.imag()).margin(0.01));
+        CHECK(moments.real_variance == Approx(variance / 2).epsilon(0.02));
+        CHECK(moments.imag_variance == Approx(variance / 2).epsilon(0.02));
+        CHECK(moments.covariance == Approx(0).margin(0.01));
+    };
+
+    SECTION("scalar")
+    {
+        std::vector<std::complex<double>> samples(sample_count);
+        for (auto& z : samples) {
+            z = dist(random);
+        }
+        check_moments(compute_moments(samples));
+    }
+
+    SECTION("bulk into array")
+    {
+        std::vector<std::complex<double>> samples(sample_count);
+        dist.generate(samples.data(), samples.data() + samples.size(), random);
+        check_moments(compute_moments(samples));
+    }
+
+    SECTION("bulk into non-contiguous range")
+    {
+        std::deque<std::complex<double>> samples(sample_count);
+        dist.generate(samples.begin(), samples.end(), random);
+        check_moments(compute_moments(samples));
+    }
+}
+
+TEST_CASE("ziggurat_complex_normal_distribution::generate - interleaves bulk normals")
+{
+    std::mt19937 random_1;
+    std::mt19937 random_2;
+
+    cxx::ziggurat_complex_normal_distribution<float> complex_normal{{}, 2};
+    std::vector<std::complex<float>> actual(300);
+    complex_normal.generate(actual.data(), actual.data() + actual.size(), random_1);
+
+    cxx::ziggurat_normal_distribution<float> normal;
+    std::vector<float> expected(600);
+    normal.generate(expected.begin(), expected.end(), random_2);
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < actual.size(); i++) {
+        mismatches += actual[i] != std::complex<float>(expected[2 * i], expected[2 * i + 1]);
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("add_noise_at_snr - adds noise of given power")
+{
+    constexpr std::size_t sample_count = 100001;
+    std::mt19937_64 random;
+
+    // QPSK symbols of unit power.
+    std::vector<std::complex<float>> signal(sample_count);
+    for (std::size_t i = 0; i < sample_count; i++) {
+        auto const s = float(1 / std::sqrt(2));
+        signal[i] = {(i & 1) ? s : -s, (i & 2) ? s : -s};
+    }
+
+    SECTION("measured signal power")
+    {
+        auto noisy = signal;
+        auto const variance = cxx::add_noise_at_snr(noisy.data(), noisy.size(), 10.0F, random);
+        CHECK(variance == Approx(0.1));
+
+        double noise_power = 0;
+        for (std::size_t i = 0; i < sample_count; i++) {
+            noise_power += std::norm(std::complex<double>(noisy[i] - signal[i]));
+        }
+        noise_power /= sample_count;
+        CHECK(noise_power == Approx(0.1).epsilon(0.02));
+    }
+
+    SECTION("given signal power")
+    {
+        auto noisy = signal;
+        auto const variance = cxx::add_noise_at_snr(noisy.data(), noisy.size(), 3.0F, 2.0F, random);
+        CHECK(variance == Approx(2 * std::pow(10, -0.3)));
+
+        double noise_power = 0;
+        for (std::size_t i = 0; i < sample_count; i++) {
+            noise_power += std::norm(std::complex<double>(noisy[i] - signal[i]));
+        }
+        noise_power /= sample_count;
+        CHECK(noise_power == Approx(variance).epsilon(0.02));
+    }
+}
+
+TEST_CASE("ziggurat_complex_normal_distribution - is serializable and deserializable")
+{
+    cxx::ziggurat_complex_normal_distribution<double> dist_1{{1.2, -3.4}, 5.6};
+    cxx::ziggurat_complex_normal_distribution<double> dist_2;
+
+    std::stringstream stream;
+    stream << dist_1;
+    stream >> dist_2;
+
+    CHECK(dist_2 == dist_1);
+}
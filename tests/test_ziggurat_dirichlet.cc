@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <ziggurat_dirichlet.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    // check_dirichlet_moments generates vectors with given concentration
+    // parameters and checks that they lie on the simplex and that each
+    // component has the marginal Beta(a_k, a_0 - a_k) mean and variance.
+    template<typename T>
+    void check_dirichlet_moments(std::vector<T> const& alpha, std::size_t count)
+    {
+        std::mt19937_64 random{1};
+        cxx::dirichlet_generator<T> dirichlet{alpha};
+
+        auto const dim = alpha.size();
+        std::vector<T> samples(count * dim);
+
+        // Uneven calls exercise partial blocks.
+        auto const split = count / 3 + 1;
+        dirichlet.generate(samples.data(), split, random);
+        dirichlet.generate(samples.data() + split * dim, count - split, random);
+
+        double alpha_sum = 0;
+        for (auto const a : alpha) {
+            alpha_sum += double(a);
+        }
+
+        std::vector<double> means(dim);
+        double max_sum_error = 0;
+        double min_sample = 1;
+        std::size_t nan_count = 0;
+
+        for (std::size_t i = 0; i < count; i++) {
+            double sum = 0;
+            for (std::size_t k = 0; k < dim; k++) {
+                auto const x = double(samples[i * dim + k]);
+                means[k] += x;
+                sum += x;
+                min_sample = std::min(min_sample, x);
+                if (std::isnan(x)) {
+                    nan_count++;
+                }
+            }
+            max_sum_error = std::max(max_sum_error, std::fabs(sum - 1));
+        }
+
+        CHECK(nan_count == 0);
+        CHECK(min_sample >= 0);
+        CHECK(max_sum_error < 1e-4);
+
+        // Errors are normalized by about 4 standard errors. The standard
+        // error of the variance uses the sample fourth moment because
+        // marginals with small concentrations are heavily skewed.
+        double max_mean_error = 0;
+        double max_var_error = 0;
+
+        for (std::size_t k = 0; k < dim; k++) {
+            auto const p = double(alpha[k]) / alpha_sum;
+            auto const expected_var = p * (1 - p) / (alpha_sum + 1);
+            auto const mean = means[k] / double(count);
+
+            double var = 0;
+            double fourth = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                auto const dev = double(samples[i * dim + k]) - mean;
+                var += dev * dev;
+                fourth += dev * dev * dev * dev;
+            }
+            var /= double(count);
+            fourth /= double(count);
+
+            auto const mean_error = std::fabs(mean - p) / std::sqrt(expected_var / double(count));
+            auto const var_error = std::fabs(var - expected_var) / std::sqrt((fourth - var * var) / double(count));
+
+            max_mean_error = std::max(max_mean_error, mean_error / 4);
+            max_var_error = std::max(max_var_error, var_error / 4);
+        }
+
+        CHECK(max_mean_error < 1);
+        CHECK(max_var_error < 1);
+    }
+}
+
+TEST_CASE("dirichlet_generator - holds concentration parameters")
+{
+    cxx::dirichlet_generator<double> dirichlet{{0.5, 1, 2}};
+    CHECK(dirichlet.dimension() == 3);
+    CHECK(dirichlet.alpha() == std::vector<double>{0.5, 1, 2});
+
+    dirichlet.alpha({3, 4});
+    CHECK(dirichlet.dimension() == 2);
+    CHECK(dirichlet.alpha() == std::vector<double>{3, 4});
+
+    cxx::dirichlet_generator<float> symmetric{5, 0.1F};
+    CHECK(symmetric.alpha() == std::vector<float>(5, 0.1F));
+}
+
+TEST_CASE("dirichlet_generator - rejects invalid concentration parameters")
+{
+    CHECK_THROWS_AS(cxx::dirichlet_generator<double>{std::vector<double>{}}, std::invalid_argument);
+    CHECK_THROWS_AS((cxx::dirichlet_generator<double>{{1, 0}}), std::invalid_argument);
+    CHECK_THROWS_AS((cxx::dirichlet_generator<double>{{1, -2}}), std::invalid_argument);
+}
+
+TEST_CASE("dirichlet_generator - generates vectors with marginal beta moments")
+{
+    SECTION("small dimension")
+    {
+        check_dirichlet_moments<double>({0.3, 1, 2.5}, 50000);
+        check_dirichlet_moments<float>({2, 5, 1, 0.7, 4}, 50000);
+    }
+
+    SECTION("dimension not dividing the block size")
+    {
+        std::vector<double> alpha(50);
+        for (std::size_t k = 0; k < alpha.size(); k++) {
+            alpha[k] = 0.2 + 0.1 * double(k);
+        }
+        check_dirichlet_moments(alpha, 20000);
+    }
+
+    SECTION("dimension larger than the block size")
+    {
+        std::vector<double> alpha(300);
+        for (std::size_t k = 0; k < alpha.size(); k++) {
+            alpha[k] = 0.5 + double(k % 7);
+        }
+        check_dirichlet_moments(alpha, 5000);
+    }
+}
+
+TEST_CASE("dirichlet_generator - normalizes sparse priors without NaN")
+{
+    // All gamma numbers of a vector often underflow to zero with these
+    // concentrations.
+    SECTION("float")
+    {
+        check_dirichlet_moments(std::vector<float>(20, 0.01F), 20000);
+        check_dirichlet_moments<float>({0.01F, 0.02F, 5, 0.005F}, 20000);
+    }
+
+    SECTION("double")
+    {
+        check_dirichlet_moments(std::vector<double>(10, 0.001), 20000);
+    }
+}
+
+TEST_CASE("dirichlet_generator - generates beta marginals for two components")
+{
+    // Dir(a, b) has the first component distributed as Beta(a, b). Beta(2, 1)
+    // has CDF x^2.
+    constexpr std::size_t sample_count = 5000;
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    std::mt19937_64 random{2};
+    cxx::dirichlet_generator<double> dirichlet{{2, 1}};
+
+    std::vector<double> samples(sample_count * 2);
+    dirichlet.generate(samples.data(), sample_count, random);
+
+    std::vector<double> firsts;
+    for (std::size_t i = 0; i < sample_count; i++) {
+        firsts.push_back(samples[i * 2]);
+    }
+    std::sort(firsts.begin(), firsts.end());
+
+    double D = 0;
+    for (std::size_t i = 0; i < sample_count; i++) {
+        auto const x = firsts[i];
+        D = std::max(D, std::fabs(double(i + 1) / sample_count - x * x));
+    }
+    CHECK(D < critical_value);
+}
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include <ziggurat_discrete.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    // discrete_ks_statistic returns the Kolmogorov-Smirnov statistic of
+    // integer samples against the discrete Gaussian with given center and
+    // sigma. The CDF is computed by summing the weights of the integers
+    // within 12 sigma of the center.
+    double discrete_ks_statistic(std::vector<long> samples, double center, double sigma)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        auto const lowest = long(std::floor(center - 12 * sigma));
+        auto const highest = long(std::ceil(center + 12 * sigma));
+
+        std::vector<double> cdf;
+        double total = 0;
+        for (long x = lowest; x <= highest; x++) {
+            auto const dx = double(x) - center;
+            total += std::exp(-dx * dx / (2 * sigma * sigma));
+            cdf.push_back(total);
+        }
+
+        double D = 0;
+        std::size_t rank = 0;
+        while (rank < samples.size()) {
+            auto const x = samples[rank];
+            while (rank < samples.size() && samples[rank] == x) {
+                rank++;
+            }
+            auto const expected = cdf[std::size_t(x - lowest)] / total;
+            D = std::max(D, std::fabs(double(rank) / double(samples.size()) - expected));
+        }
+        return D;
+    }
+}
+
+TEST_CASE("ziggurat_discrete_gaussian_distribution::result_type - is the template argument")
+{
+    CHECK(std::is_same<cxx::ziggurat_discrete_gaussian_distribution<>::result_type, int>::value);
+    CHECK(std::is_same<cxx::ziggurat_discrete_gaussian_distribution<std::int64_t>::result_type, std::int64_t>::value);
+}
+
+TEST_CASE("ziggurat_discrete_gaussian_distribution - holds center and sigma")
+{
+    cxx::ziggurat_discrete_gaussian_distribution<int> const default_dist;
+    CHECK(default_dist.center() == 0);
+    CHECK(default_dist.sigma() == 1);
+    CHECK(default_dist.min() == std::numeric_limits<int>::min());
+    CHECK(default_dist.max() == std::numeric_limits<int>::max());
+
+    cxx::ziggurat_discrete_gaussian_distribution<int> dist;
+    cxx::ziggurat_discrete_gaussian_distribution<int>::param_type const param{2.5, 3.2};
+    dist.param(param);
+    CHECK(dist.param() == param);
+    CHECK(dist.center() == 2.5);
+    CHECK(dist.sigma() == 3.2);
+    CHECK(dist == cxx::ziggurat_discrete_gaussian_distribution<int>{2.5, 3.2});
+    CHECK(dist != default_dist);
+}
+
+TEST_CASE("ziggurat_discrete_gaussian_distribution - generates discrete Gaussian integers")
+{
+    constexpr std::size_t sample_count = 10000;
+
+    // KS test (two-sided, 1%). The test is conservative for discrete
+    // distributions.
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    struct parameter
+    {
+        double center;
+        double sigma;
+    };
+
+    // The small widths use the table and the large ones use rejection.
+    std::vector<parameter> const parameters = {
+        {0, 0.6},
+        {0.5, 1},
+        {-2.7, 3.2},
+        {100.25, 40},
+        {0, 300},
+        {-1234.5, 2000},
+    };
+
+    for (auto const& param : parameters) {
+        std::mt19937_64 random{4};
+        cxx::ziggurat_discrete_gaussian_distribution<long> dist{param.center, param.sigma};
+
+        std::vector<long> scalar_samples;
+        std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+            return dist(random);
+        });
+
+        std::vector<long> bulk_samples(sample_count);
+        dist.generate(bulk_samples.begin(), bulk_samples.end(), random);
+
+        CHECK(discrete_ks_statistic(scalar_samples, param.center, param.sigma) < critical_value);
+        CHECK(discrete_ks_statistic(bulk_samples, param.center, param.sigma) < critical_value);
+    }
+}
+
+TEST_CASE("ziggurat_discrete_gaussian_distribution - has correct moments")
+{
+    constexpr std::size_t sample_count = 200000;
+
+    // The variance of a discrete Gaussian approaches sigma^2 as sigma grows.
+    for (double sigma : {20.0, 1000.0}) {
+        std::mt19937 random;
+        cxx::ziggurat_discrete_gaussian_distribution<std::int64_t> dist{1e6 + 0.25, sigma};
+
+        std::vector<std::int64_t> samples(sample_count);
+        dist.generate(samples.begin(), samples.end(), random);
+
+        double mean = 0;
+        for (auto x : samples) {
+            mean += double(x - 1000000);
+        }
+        mean /= sample_count;
+
+        double var = 0;
+        for (auto x : samples) {
+            var += (double(x - 1000000) - mean) * (double(x - 1000000) - mean);
+        }
+        var /= sample_count;
+
+        CHECK(std::fabs(mean - 0.25) < 4 * sigma / std::sqrt(sample_count));
+        CHECK(var == Approx(sigma * sigma).epsilon(0.015));
+    }
+}
+
+TEST_CASE("ziggurat_discrete_gaussian_distribution - applies ad-hoc parameters")
+{
+    std::mt19937_64 random;
+    cxx::ziggurat_discrete_gaussian_distribution<int> dist;
+    cxx::ziggurat_discrete_gaussian_distribution<int>::param_type const param{-10, 0.3};
+
+    // With sigma 0.3, the center has probability 1 - 2 exp(-1/0.18) roughly.
+    constexpr std::size_t sample_count = 1000;
+
+    std::vector<int> samples;
+    std::generate_n(std::back_inserter(samples), sample_count, [&] {
+        return dist(random, param);
+    });
+    std::vector<int> bulk_samples(sample_count);
+    dist.generate(bulk_samples.begin(), bulk_samples.end(), random, param);
+    samples.insert(samples.end(), bulk_samples.begin(), bulk_samples.end());
+
+    auto const centered = std::count(samples.begin(), samples.end(), -10);
+    auto const neighbors = std::count(samples.begin(), samples.end(), -11)
+        + std::count(samples.begin(), samples.end(), -9);
+
+    CHECK(std::size_t(centered + neighbors) == samples.size());
+    CHECK(centered > 2 * std::int64_t(sample_count) * 95 / 100);
+}
+
+TEST_CASE("ziggurat_discrete_gaussian_distribution - is serializable and deserializable")
+{
+    cxx::ziggurat_discrete_gaussian_distribution<int> dist_1{1.5, 2.5};
+    cxx::ziggurat_discrete_gaussian_distribution<int> dist_2;
+
+    std::stringstream stream;
+    stream << dist_1;
+    stream >> dist_2;
+
+    CHECK(dist_2 == dist_1);
+}
@@ -0,0 +1,66 @@
+#include <cstddef>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_execution.hpp>
+#include <ziggurat_parallel.hpp>
+
+#include <catch.hpp>
+
+
+TEST_CASE("generate_normal - is identical to parallel_generate")
+{
+    std::size_t const size = 100000;
+
+    std::vector<double> expected(size);
+    cxx::parallel_generate(expected.begin(), expected.end(), 123);
+
+    std::vector<double> seq_output(size);
+    cxx::generate_normal(cxx::execution::seq, seq_output.begin(), seq_output.end(), 123);
+    CHECK(seq_output == expected);
+
+    std::vector<double> par_output(size);
+    cxx::generate_normal(cxx::execution::par, par_output.begin(), par_output.end(), 123);
+    CHECK(par_output == expected);
+
+    std::vector<double> par_unseq_output(size);
+    cxx::generate_normal(
+        cxx::execution::par_unseq, par_unseq_output.begin(), par_unseq_output.end(), 123
+    );
+    CHECK(par_unseq_output == expected);
+}
+
+TEST_CASE("generate_normal - applies parameters")
+{
+    cxx::ziggurat_normal_distribution<float>::param_type const param{1.5f, 0.25f};
+
+    std::vector<float> expected(50000);
+    cxx::parallel_generate(expected.begin(), expected.end(), 42, param);
+
+    std::vector<float> output(50000);
+    cxx::generate_normal(cxx::execution::par, output.begin(), output.end(), 42, param);
+    CHECK(output == expected);
+
+    double mean = 0;
+    for (float x : output) {
+        mean += x;
+    }
+    mean /= double(output.size());
+    CHECK(mean == Approx(1.5).margin(0.01));
+}
+
+TEST_CASE("generate_normal - depends on seed")
+{
+    std::vector<double> output_1(1000);
+    std::vector<double> output_2(1000);
+    cxx::generate_normal(cxx::execution::par, output_1.begin(), output_1.end(), 1);
+    cxx::generate_normal(cxx::execution::par, output_2.begin(), output_2.end(), 2);
+    CHECK(output_1 != output_2);
+}
+
+TEST_CASE("generate_normal - accepts empty range")
+{
+    std::vector<double> output;
+    cxx::generate_normal(cxx::execution::par, output.begin(), output.end(), 1);
+    CHECK(output.empty());
+}
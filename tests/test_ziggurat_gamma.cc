@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include <ziggurat_gamma.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    // ks_statistic returns the Kolmogorov-Smirnov statistic of samples
+    // against a distribution having given CDF.
+    double ks_statistic(std::vector<double> samples, std::function<double(double)> cdf)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        double D = 0;
+        double rank = 0;
+        for (double x : samples) {
+            rank++;
+            D = std::max(D, std::fabs(rank / double(samples.size()) - cdf(x)));
+        }
+        return D;
+    }
+
+    // check_small_shape_beta checks that beta numbers with tiny shapes, for
+    // which both gamma numbers often underflow to zero, are in [0, 1] and
+    // have the mean a / (a + b).
+    template<typename T>
+    void check_small_shape_beta(T a, T b)
+    {
+        constexpr std::size_t sample_count = 100000;
+
+        std::mt19937 random;
+        cxx::ziggurat_beta_distribution<T> beta{a, b};
+
+        std::vector<T> scalar_samples;
+        std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+            return beta(random);
+        });
+
+        std::vector<T> bulk_samples(sample_count);
+        beta.generate(bulk_samples.begin(), bulk_samples.end(), random);
+
+        auto const mean = double(a) / (double(a) + double(b));
+        auto const var = mean * (1 - mean) / (double(a) + double(b) + 1);
+
+        for (auto const& samples : {scalar_samples, bulk_samples}) {
+            auto const nan_count = std::count_if(samples.begin(), samples.end(), [](T x) {
+                return std::isnan(x);
+            });
+            CHECK(nan_count == 0);
+            CHECK(*std::min_element(samples.begin(), samples.end()) >= 0);
+            CHECK(*std::max_element(samples.begin(), samples.end()) <= 1);
+
+            double sum = 0;
+            for (T x : samples) {
+                sum += double(x);
+            }
+            CHECK(sum / sample_count == Approx(mean).margin(4 * std::sqrt(var / sample_count)));
+        }
+    }
+
+    // gamma_cdfs lists shapes having closed-form CDFs (unit scale).
+    struct gamma_cdf
+    {
+        double alpha;
+        std::function<double(double)> cdf;
+    };
+
+    std::vector<gamma_cdf> const gamma_cdfs = {
+        {0.5, [](double x) { return std::erf(std::sqrt(x)); }},
+        {1.0, [](double x) { return 1 - std::exp(-x); }},
+        {2.0, [](double x) { return 1 - std::exp(-x) * (1 + x); }},
+        {3.0, [](double x) { return 1 - std::exp(-x) * (1 + x + x * x / 2); }},
+    };
+}
+
+TEST_CASE("ziggurat_gamma_distribution::result_type - is the template argument")
+{
+    CHECK(std::is_same<cxx::ziggurat_gamma_distribution<float>::result_type, float>::value);
+    CHECK(std::is_same<cxx::ziggurat_gamma_distribution<double>::result_type, double>::value);
+}
+
+TEST_CASE("ziggurat_gamma_distribution::param_type - holds shape and scale")
+{
+    cxx::ziggurat_gamma_distribution<double>::param_type const default_param;
+    CHECK(default_param.alpha() == 1);
+    CHECK(default_param.beta() == 1);
+
+    cxx::ziggurat_gamma_distribution<double>::param_type const param{2.5, 0.5};
+    CHECK(param.alpha() == 2.5);
+    CHECK(param.beta() == 0.5);
+    CHECK(param != default_param);
+    CHECK(param == cxx::ziggurat_gamma_distribution<double>::param_type{2.5, 0.5});
+}
+
+TEST_CASE("ziggurat_gamma_distribution - is constructible with parameters")
+{
+    cxx::ziggurat_gamma_distribution<float> const dist{2.5F, 0.5F};
+
+    CHECK(dist.alpha() == 2.5F);
+    CHECK(dist.beta() == 0.5F);
+    CHECK(dist.min() == 0);
+    CHECK(dist.max() == std::numeric_limits<float>::infinity());
+}
+
+TEST_CASE("ziggurat_gamma_distribution::param - resets parameters")
+{
+    cxx::ziggurat_gamma_distribution<double> dist;
+    cxx::ziggurat_gamma_distribution<double>::param_type const param{0.3, 2};
+
+    dist.param(param);
+    CHECK(dist.param() == param);
+    CHECK(dist == cxx::ziggurat_gamma_distribution<double>{param});
+}
+
+TEST_CASE("ziggurat_gamma_distribution - generates gamma distributed numbers")
+{
+    constexpr std::size_t sample_count = 5000;
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    for (auto const& shape : gamma_cdfs) {
+        std::mt19937_64 random{3};
+        cxx::ziggurat_gamma_distribution<double> gamma{shape.alpha};
+
+        std::vector<double> samples;
+        std::generate_n(std::back_inserter(samples), sample_count, [&] {
+            return gamma(random);
+        });
+
+        CHECK(ks_statistic(samples, shape.cdf) < critical_value);
+    }
+}
+
+TEST_CASE("ziggurat_gamma_distribution::generate - generates gamma distributed numbers")
+{
+    constexpr std::size_t sample_count = 5000;
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    for (auto const& shape : gamma_cdfs) {
+        std::mt19937_64 random{3};
+        cxx::ziggurat_gamma_distribution<double> gamma{shape.alpha};
+
+        std::vector<double> samples(sample_count);
+        gamma.generate(samples.begin(), samples.end(), random);
+
+        CHECK(ks_statistic(samples, shape.cdf) < critical_value);
+    }
+}
+
+TEST_CASE("ziggurat_gamma_distribution - applies scale and ad-hoc parameters")
+{
+    std::mt19937 random;
+    cxx::ziggurat_gamma_distribution<float> gamma;
+    cxx::ziggurat_gamma_distribution<float>::param_type const param{0.2F, 3.0F};
+
+    constexpr std::size_t sample_count = 100000;
+
+    std::vector<float> scalar_samples;
+    std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+        return gamma(random, param);
+    });
+
+    std::vector<float> bulk_samples(sample_count);
+    gamma.generate(bulk_samples.begin(), bulk_samples.end(), random, param);
+
+    for (auto const& samples : {scalar_samples, bulk_samples}) {
+        CHECK(*std::min_element(samples.begin(), samples.end()) >= 0);
+
+        double mean = 0;
+        double var = 0;
+        for (float x : samples) {
+            mean += x;
+        }
+        mean /= sample_count;
+        for (float x : samples) {
+            var += (x - mean) * (x - mean);
+        }
+        var /= sample_count;
+
+        CHECK(mean == Approx(0.2 * 3).epsilon(0.03));
+        CHECK(var == Approx(0.2 * 3 * 3).epsilon(0.05));
+    }
+}
+
+TEST_CASE("ziggurat_gamma_distribution - is serializable and deserializable")
+{
+    cxx::ziggurat_gamma_distribution<double> dist_1{1.5, 2.5};
+    cxx::ziggurat_gamma_distribution<double> dist_2;
+
+    std::stringstream stream;
+    stream << dist_1;
+    stream >> dist_2;
+
+    CHECK(dist_2 == dist_1);
+}
+
+TEST_CASE("ziggurat_chi_squared_distribution - holds degrees of freedom")
+{
+    cxx::ziggurat_chi_squared_distribution<double> const default_dist;
+    CHECK(default_dist.n() == 1);
+
+    cxx::ziggurat_chi_squared_distribution<double> const dist{4.5};
+    CHECK(dist.n() == 4.5);
+    CHECK(dist.min() == 0);
+    CHECK(dist != default_dist);
+    CHECK(dist == cxx::ziggurat_chi_squared_distribution<double>{
+        cxx::ziggurat_chi_squared_distribution<double>::param_type{4.5}
+    });
+}
+
+TEST_CASE("ziggurat_chi_squared_distribution - generates chi-squared distributed numbers")
+{
+    constexpr std::size_t sample_count = 5000;
+    double const pi = std::acos(-1.0);
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    // Sums of squares (n <= 2) and the gamma route (n > 2).
+    std::vector<gamma_cdf> const chi_squared_cdfs = {
+        {1, [](double x) { return std::erf(std::sqrt(x / 2)); }},
+        {2, [](double x) { return 1 - std::exp(-x / 2); }},
+        {3, [=](double x) {
+            return std::erf(std::sqrt(x / 2)) - std::sqrt(2 * x / pi) * std::exp(-x / 2);
+        }},
+        {4, [](double x) { return 1 - std::exp(-x / 2) * (1 + x / 2); }},
+        {6, [](double x) { return 1 - std::exp(-x / 2) * (1 + x / 2 + x * x / 8); }},
+    };
+
+    for (auto const& dof : chi_squared_cdfs) {
+        std::mt19937_64 random{5};
+        cxx::ziggurat_chi_squared_distribution<double> chi_squared{dof.alpha};
+
+        std::vector<double> scalar_samples;
+        std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+            return chi_squared(random);
+        });
+        CHECK(ks_statistic(scalar_samples, dof.cdf) < critical_value);
+
+        std::vector<double> bulk_samples(sample_count);
+        chi_squared.generate(bulk_samples.begin(), bulk_samples.end(), random);
+        CHECK(ks_statistic(bulk_samples, dof.cdf) < critical_value);
+    }
+}
+
+TEST_CASE("ziggurat_chi_squared_distribution - has correct moments for fractional n")
+{
+    std::mt19937_64 random;
+    cxx::ziggurat_chi_squared_distribution<double> chi_squared;
+    cxx::ziggurat_chi_squared_distribution<double>::param_type const param{2.5};
+
+    std::vector<double> samples(100000);
+    chi_squared.generate(samples.begin(), samples.end(), random, param);
+
+    double mean = 0;
+    double var = 0;
+    for (double x : samples) {
+        mean += x;
+    }
+    mean /= double(samples.size());
+    for (double x : samples) {
+        var += (x - mean) * (x - mean);
+    }
+    var /= double(samples.size());
+
+    CHECK(mean == Approx(2.5).epsilon(0.02));
+    CHECK(var == Approx(5).epsilon(0.05));
+    CHECK(chi_squared(random, param) >= 0);
+}
+
+TEST_CASE("ziggurat_student_t_distribution - holds degrees of freedom")
+{
+    cxx::ziggurat_student_t_distribution<float> const default_dist;
+    CHECK(default_dist.n() == 1);
+
+    cxx::ziggurat_student_t_distribution<float> dist{3.5F};
+    CHECK(dist.n() == 3.5F);
+    CHECK(dist.min() == -std::numeric_limits<float>::infinity());
+
+    dist.param(default_dist.param());
+    CHECK(dist == default_dist);
+}
+
+TEST_CASE("ziggurat_student_t_distribution - generates t distributed numbers")
+{
+    constexpr std::size_t sample_count = 5000;
+    double const pi = std::acos(-1.0);
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    std::vector<gamma_cdf> const t_cdfs = {
+        {1, [=](double x) { return 0.5 + std::atan(x) / pi; }},
+        {2, [](double x) { return 0.5 + x / (2 * std::sqrt(2 + x * x)); }},
+        {3, [=](double x) {
+            double const s = std::sqrt(3.0);
+            return 0.5 + (x / (s * (1 + x * x / 3)) + std::atan(x / s)) / pi;
+        }},
+    };
+
+    for (auto const& dof : t_cdfs) {
+        std::mt19937_64 random{5};
+        cxx::ziggurat_student_t_distribution<double> student_t{dof.alpha};
+
+        std::vector<double> scalar_samples;
+        std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+            return student_t(random);
+        });
+        CHECK(ks_statistic(scalar_samples, dof.cdf) < critical_value);
+
+        std::vector<double> bulk_samples(sample_count);
+        student_t.generate(bulk_samples.begin(), bulk_samples.end(), random);
+        CHECK(ks_statistic(bulk_samples, dof.cdf) < critical_value);
+    }
+}
+
+TEST_CASE("ziggurat_student_t_distribution - has correct variance for fractional n")
+{
+    std::mt19937_64 random;
+    cxx::ziggurat_student_t_distribution<double> student_t;
+    cxx::ziggurat_student_t_distribution<double>::param_type const param{9.5};
+
+    std::vector<double> samples(200000);
+    student_t.generate(samples.begin(), samples.end(), random, param);
+
+    double var = 0;
+    for (double x : samples) {
+        var += x * x;
+    }
+    var /= double(samples.size());
+
+    CHECK(var == Approx(9.5 / 7.5).epsilon(0.03));
+}
+
+TEST_CASE("ziggurat_student_t_distribution - is serializable and deserializable")
+{
+    cxx::ziggurat_student_t_distribution<double> dist_1{5.5};
+    cxx::ziggurat_student_t_distribution<double> dist_2;
+
+    std::stringstream stream;
+    stream << dist_1;
+    stream >> dist_2;
+
+    CHECK(dist_2 == dist_1);
+}
+
+TEST_CASE("ziggurat_beta_distribution - holds shape parameters")
+{
+    cxx::ziggurat_beta_distribution<double> const default_dist;
+    CHECK(default_dist.alpha() == 1);
+    CHECK(default_dist.beta() == 1);
+    CHECK(default_dist.min() == 0);
+    CHECK(default_dist.max() == 1);
+
+    cxx::ziggurat_beta_distribution<double> dist;
+    cxx::ziggurat_beta_distribution<double>::param_type const param{0.5, 2};
+    dist.param(param);
+    CHECK(dist.param() == param);
+    CHECK(dist == cxx::ziggurat_beta_distribution<double>{0.5, 2});
+}
+
+TEST_CASE("ziggurat_beta_distribution - generates beta distributed numbers")
+{
+    constexpr std::size_t sample_count = 5000;
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    struct beta_cdf
+    {
+        double alpha;
+        double beta;
+        std::function<double(double)> cdf;
+    };
+
+    std::vector<beta_cdf> const beta_cdfs = {
+        {1.0, 1.0, [](double x) { return x; }},
+        {2.0, 1.0, [](double x) { return x * x; }},
+        {1.0, 3.0, [](double x) { return 1 - (1 - x) * (1 - x) * (1 - x); }},
+        {2.0, 2.0, [](double x) { return x * x * (3 - 2 * x); }},
+        {0.5, 0.5, [](double x) { return std::asin(std::sqrt(x)) / std::asin(1.0); }},
+    };
+
+    for (auto const& shape : beta_cdfs) {
+        std::mt19937_64 random{3};
+        cxx::ziggurat_beta_distribution<double> beta{shape.alpha, shape.beta};
+
+        std::vector<double> scalar_samples;
+        std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+            return beta(random);
+        });
+
+        std::vector<double> bulk_samples(sample_count);
+        beta.generate(bulk_samples.begin(), bulk_samples.end(), random);
+
+        CHECK(ks_statistic(scalar_samples, shape.cdf) < critical_value);
+        CHECK(ks_statistic(bulk_samples, shape.cdf) < critical_value);
+    }
+}
+
+TEST_CASE("ziggurat_beta_distribution - applies ad-hoc parameters")
+{
+    std::mt19937 random;
+    cxx::ziggurat_beta_distribution<float> beta;
+    cxx::ziggurat_beta_distribution<float>::param_type const param{0.3F, 4.0F};
+
+    constexpr std::size_t sample_count = 100000;
+
+    std::vector<float> scalar_samples;
+    std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+        return beta(random, param);
+    });
+
+    std::vector<float> bulk_samples(sample_count);
+    beta.generate(bulk_samples.begin(), bulk_samples.end(), random, param);
+
+    // Beta(a, b) has mean a / (a + b) and variance ab / (a + b)^2 (a + b + 1).
+    double const a = 0.3;
+    double const b = 4.0;
+
+    for (auto const& samples : {scalar_samples, bulk_samples}) {
+        CHECK(*std::min_element(samples.begin(), samples.end()) >= 0);
+        CHECK(*std::max_element(samples.begin(), samples.end()) <= 1);
+
+        double mean = 0;
+        double var = 0;
+        for (float x : samples) {
+            mean += x;
+        }
+        mean /= sample_count;
+        for (float x : samples) {
+            var += (x - mean) * (x - mean);
+        }
+        var /= sample_count;
+
+        CHECK(mean == Approx(a / (a + b)).epsilon(0.03));
+        CHECK(var == Approx(a * b / ((a + b) * (a + b) * (a + b + 1))).epsilon(0.05));
+    }
+}
+
+TEST_CASE("ziggurat_beta_distribution - does not give NaN for small shapes")
+{
+    SECTION("float")
+    {
+        check_small_shape_beta(0.01F, 0.01F);
+        check_small_shape_beta(0.01F, 2.0F);
+    }
+
+    SECTION("double")
+    {
+        check_small_shape_beta(0.001, 0.001);
+        check_small_shape_beta(3.0, 0.001);
+    }
+}
+
+TEST_CASE("ziggurat_beta_distribution - is serializable and deserializable")
+{
+    cxx::ziggurat_beta_distribution<double> dist_1{1.5, 2.5};
+    cxx::ziggurat_beta_distribution<double> dist_2;
+
+    std::stringstream stream;
+    stream << dist_1;
+    stream >> dist_2;
+
+    CHECK(dist_2 == dist_1);
+}
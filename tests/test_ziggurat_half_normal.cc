@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <ziggurat_half_normal.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    // half_normal_ks_statistic returns the Kolmogorov-Smirnov statistic of
+    // samples against the half-normal distribution with given sigma.
+    template<typename T>
+    double half_normal_ks_statistic(std::vector<T> samples, double sigma)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        double D = 0;
+        double rank = 0;
+        for (T x : samples) {
+            rank++;
+            double const cdf = std::erf(double(x) / (sigma * std::sqrt(2)));
+            D = std::max(D, std::fabs(rank / double(samples.size()) - cdf));
+        }
+        return D;
+    }
+}
+
+TEST_CASE("half_normal_ziggurat - has a 256-layer table")
+{
+    using ziggurat = cxx::ziggurat_detail::half_normal_ziggurat<double>;
+
+    // The base strip edge of the 256-layer ziggurat (Marsaglia and Tsang).
+    CHECK(ziggurat::edges[1] == Approx(3.6541528853610088));
+    CHECK(ziggurat::edges[0x100] == Approx(0).margin(1e-6));
+    CHECK(std::is_sorted(std::begin(ziggurat::edges), std::end(ziggurat::edges), std::greater<double>()));
+}
+
+TEST_CASE("ziggurat_half_normal_distribution - holds parameters")
+{
+    cxx::ziggurat_half_normal_distribution<double> const default_dist;
+    CHECK(default_dist.sigma() == 1);
+    CHECK(default_dist.min() == 0);
+    CHECK(default_dist.max() == std::numeric_limits<double>::infinity());
+
+    cxx::ziggurat_half_normal_distribution<double> dist{2.5};
+    CHECK(dist.sigma() == 2.5);
+    CHECK(dist != default_dist);
+
+    dist.param(default_dist.param());
+    CHECK(dist == default_dist);
+}
+
+TEST_CASE("ziggurat_half_normal_distribution - generates half-normal numbers")
+{
+    constexpr std::size_t sample_count = 10000;
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    SECTION("double with 64-bit engine")
+    {
+        std::mt19937_64 random;
+        cxx::ziggurat_half_normal_distribution<double> half_normal{1.5};
+
+        std::vector<double> scalar_samples;
+        std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+            return half_normal(random);
+        });
+        CHECK(half_normal_ks_statistic(scalar_samples, 1.5) < critical_value);
+
+        std::vector<double> bulk_samples(sample_count);
+        half_normal.generate(bulk_samples.begin(), bulk_samples.end(), random);
+        CHECK(half_normal_ks_statistic(bulk_samples, 1.5) < critical_value);
+        CHECK(*std::min_element(bulk_samples.begin(), bulk_samples.end()) >= 0);
+    }
+
+    SECTION("float with 32-bit engine")
+    {
+        std::mt19937 random{1};
+        cxx::ziggurat_half_normal_distribution<float> half_normal;
+
+        std::vector<float> scalar_samples;
+        std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+            return half_normal(random);
+        });
+        CHECK(half_normal_ks_statistic(scalar_samples, 1) < critical_value);
+
+        std::vector<float> bulk_samples(sample_count);
+        half_normal.generate(bulk_samples.begin(), bulk_samples.end(), random);
+        CHECK(half_normal_ks_statistic(bulk_samples, 1) < critical_value);
+        CHECK(*std::min_element(bulk_samples.begin(), bulk_samples.end()) >= 0);
+    }
+}
+
+TEST_CASE("ziggurat_half_normal_distribution - samples the tail")
+{
+    std::mt19937_64 random;
+    cxx::ziggurat_half_normal_distribution<double> half_normal;
+
+    // P(|Z| > 3.6541...) is about 2.6e-4.
+    constexpr std::size_t sample_count = 1000000;
+    std::vector<double> samples(sample_count);
+    half_normal.generate(samples.begin(), samples.end(), random);
+
+    auto const tail_edge = cxx::ziggurat_detail::half_normal_ziggurat<double>::edges[1];
+    auto const tail_count = std::count_if(samples.begin(), samples.end(), [&](double x) {
+        return x > tail_edge;
+    });
+    auto const expected = double(sample_count) * std::erfc(tail_edge / std::sqrt(2));
+
+    CHECK(double(tail_count) == Approx(expected).epsilon(0.2));
+}
+
+TEST_CASE("ziggurat_half_normal_distribution - is serializable and deserializable")
+{
+    cxx::ziggurat_half_normal_distribution<double> dist_1{3.4};
+    cxx::ziggurat_half_normal_distribution<double> dist_2;
+
+    std::stringstream stream;
+    stream << dist_1;
+    stream >> dist_2;
+
+    CHECK(dist_2 == dist_1);
+}
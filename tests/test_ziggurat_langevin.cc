@@ -0,0 +1,136 @@
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <ziggurat_langevin.hpp>
+
+#include <catch.hpp>
+
+
+TEST_CASE("apply_langevin_noise - applies friction and scaled noise")
+{
+    constexpr std::size_t count = 1000;
+    double const c1 = 0.9;
+    double const c2 = 0.4;
+
+    std::vector<double> velocity(count);
+    std::vector<double> scale(count);
+    for (std::size_t i = 0; i < count; i++) {
+        velocity[i] = double(i % 7) - 3;
+        scale[i] = 1 / std::sqrt(double(1 + i % 5));
+    }
+    auto const initial = velocity;
+
+    std::mt19937_64 random;
+    std::mt19937_64 expected_random = random;
+    cxx::apply_langevin_noise(velocity.data(), scale.data(), count, c1, c2, random);
+
+    std::vector<double> noise(count);
+    cxx::ziggurat_normal_distribution<double> normal;
+    normal.generate(noise.begin(), noise.end(), expected_random);
+
+    for (std::size_t i = 0; i < count; i++) {
+        CHECK(velocity[i] == Approx(c1 * initial[i] + c2 * scale[i] * noise[i]));
+    }
+    CHECK(random == expected_random);
+}
+
+TEST_CASE("apply_langevin_noise3 - shares scale among components of a particle")
+{
+    constexpr std::size_t particle_count = 300;
+    float const c1 = 0.5f;
+    float const c2 = 0.8f;
+
+    std::vector<float> velocity(3 * particle_count);
+    std::vector<float> scale(particle_count);
+    for (std::size_t i = 0; i < velocity.size(); i++) {
+        velocity[i] = float(i % 5) - 2;
+    }
+    for (std::size_t p = 0; p < particle_count; p++) {
+        scale[p] = float(1 + p % 3);
+    }
+    auto const initial = velocity;
+
+    std::mt19937_64 random;
+    std::mt19937_64 expected_random = random;
+    cxx::apply_langevin_noise3(velocity.data(), scale.data(), particle_count, c1, c2, random);
+
+    std::vector<float> noise(velocity.size());
+    cxx::ziggurat_normal_distribution<float> normal;
+    normal.generate(noise.begin(), noise.end(), expected_random);
+
+    for (std::size_t i = 0; i < velocity.size(); i++) {
+        auto const expected = c1 * initial[i] + c2 * scale[i / 3] * noise[i];
+        CHECK(velocity[i] == Approx(expected).margin(1e-6));
+    }
+    CHECK(random == expected_random);
+}
+
+TEST_CASE("apply_langevin_noise3 - samples Ornstein-Uhlenbeck velocity transition")
+{
+    constexpr std::size_t particle_count = 50001;
+    double const kT = 2;
+    double const friction = 3;
+    double const dt = 0.1;
+    double const v0 = 1.5;
+
+    auto const c1 = std::exp(-friction * dt);
+    auto const c2 = std::sqrt(-std::expm1(-2 * friction * dt));
+
+    std::vector<double> mass(particle_count);
+    std::vector<double> scale(particle_count);
+    for (std::size_t p = 0; p < particle_count; p++) {
+        mass[p] = double(1 + p % 10);
+        scale[p] = std::sqrt(kT / mass[p]);
+    }
+    std::vector<double> velocity(3 * particle_count, v0);
+
+    std::mt19937_64 random;
+    cxx::apply_langevin_noise3(velocity.data(), scale.data(), particle_count, c1, c2, random);
+
+    // The standardized residuals should be standard normal.
+    double sum = 0;
+    double sum_sq = 0;
+    for (std::size_t i = 0; i < velocity.size(); i++) {
+        auto const z = (velocity[i] - c1 * v0) / (c2 * scale[i / 3]);
+        sum += z;
+        sum_sq += z * z;
+    }
+    auto const n = double(velocity.size());
+    auto const mean = sum / n;
+    auto const variance = sum_sq / n - mean * mean;
+
+    CHECK(mean == Approx(0).margin(4 / std::sqrt(n)));
+    CHECK(variance == Approx(1).margin(4 * std::sqrt(2 / n)));
+}
+
+TEST_CASE("apply_langevin_noise3 - does not depend on block-aligned splits")
+{
+    constexpr std::size_t first_count = 256;
+    constexpr std::size_t second_count = 44;
+    constexpr std::size_t particle_count = first_count + second_count;
+
+    std::vector<double> scale(particle_count);
+    for (std::size_t p = 0; p < particle_count; p++) {
+        scale[p] = double(1 + p % 4);
+    }
+    std::vector<double> whole(3 * particle_count, 1);
+    std::vector<double> split(3 * particle_count, 1);
+
+    std::mt19937_64 whole_random;
+    std::mt19937_64 split_random;
+
+    cxx::apply_langevin_noise3(whole.data(), scale.data(), particle_count, 0.7, 0.3, whole_random);
+    cxx::apply_langevin_noise3(split.data(), scale.data(), first_count, 0.7, 0.3, split_random);
+    cxx::apply_langevin_noise3(
+        split.data() + 3 * first_count,
+        scale.data() + first_count,
+        second_count,
+        0.7,
+        0.3,
+        split_random
+    );
+
+    CHECK(split == whole);
+}
@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <ziggurat_lognormal.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    // lognormal_ks_statistic returns the Kolmogorov-Smirnov statistic of
+    // samples against the lognormal distribution with given parameters.
+    double lognormal_ks_statistic(std::vector<double> samples, double m, double s)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        double D = 0;
+        double rank = 0;
+        for (double x : samples) {
+            rank++;
+            double const cdf = 1 - std::erfc((std::log(x) - m) / (s * std::sqrt(2))) / 2;
+            D = std::max(D, std::fabs(rank / double(samples.size()) - cdf));
+        }
+        return D;
+    }
+
+    // check_range_edges checks that the lognormal numbers with m = 0 and
+    // given s generated by generate and operator() are std::exp of normal
+    // numbers, including the infinities and zeros out of the range of exp.
+    template<typename T>
+    void check_range_edges(double s)
+    {
+        constexpr std::size_t sample_count = 1000;
+
+        std::mt19937 random_1;
+        std::mt19937 random_2;
+
+        cxx::ziggurat_lognormal_distribution<T> lognormal{0, T(s)};
+        std::vector<T> actual(sample_count);
+        lognormal.generate(actual.begin(), actual.end(), random_1);
+
+        cxx::ziggurat_normal_distribution<T> normal{0, T(s)};
+        std::vector<T> args(sample_count);
+        normal.generate(args.begin(), args.end(), random_2);
+
+        std::size_t inf_count = 0;
+        std::size_t zero_count = 0;
+
+        for (std::size_t i = 0; i < sample_count; i++) {
+            auto const expected = std::exp(args[i]);
+
+            if (std::isinf(expected)) {
+                CHECK(actual[i] == expected);
+                inf_count++;
+            } else if (expected == 0) {
+                CHECK(actual[i] == 0);
+                zero_count++;
+            } else {
+                auto const margin = double(std::numeric_limits<T>::denorm_min());
+                CHECK(double(actual[i]) == Approx(double(expected)).epsilon(1e-6).margin(margin));
+            }
+        }
+        CHECK(inf_count > 0);
+        CHECK(zero_count > 0);
+
+        // operator() is std::exp of a scalar normal number.
+        std::size_t scalar_inf_count = 0;
+        std::size_t scalar_zero_count = 0;
+
+        for (std::size_t i = 0; i < sample_count; i++) {
+            auto const x = lognormal(random_1);
+            if (std::isinf(x)) {
+                scalar_inf_count++;
+            }
+            if (x == 0) {
+                scalar_zero_count++;
+            }
+        }
+        CHECK(scalar_inf_count > 0);
+        CHECK(scalar_zero_count > 0);
+    }
+}
+
+TEST_CASE("exp_block - is accurate")
+{
+    std::mt19937_64 random;
+
+    SECTION("double")
+    {
+        std::uniform_real_distribution<double> uniform{-700, 700};
+        std::vector<double> args(1000);
+        std::generate(args.begin(), args.end(), [&] { return uniform(random); });
+
+        std::vector<double> values = args;
+        cxx::ziggurat_detail::exp_block(values.data(), values.size());
+
+        double max_error = 0;
+        for (std::size_t i = 0; i < args.size(); i++) {
+            max_error = std::max(max_error, std::fabs(values[i] / std::exp(args[i]) - 1));
+        }
+        CHECK(max_error < 1e-15);
+    }
+
+    SECTION("float")
+    {
+        std::uniform_real_distribution<float> uniform{-80, 80};
+        std::vector<float> args(1000);
+        std::generate(args.begin(), args.end(), [&] { return uniform(random); });
+
+        std::vector<float> values = args;
+        cxx::ziggurat_detail::exp_block(values.data(), values.size());
+
+        double max_error = 0;
+        for (std::size_t i = 0; i < args.size(); i++) {
+            max_error = std::max(max_error, std::fabs(double(values[i]) / std::exp(double(args[i])) - 1));
+        }
+        CHECK(max_error < 1e-6);
+    }
+}
+
+TEST_CASE("exp_block - overflows and underflows as std::exp")
+{
+    double const inf = std::numeric_limits<double>::infinity();
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+
+    // Arguments around the double limits 709.78 and -745.13. Divided by 8,
+    // they are around the float limits 88.72 and -103.97 too.
+    std::vector<double> const args = {
+        0, 700, 709.7, 709.8, 710, 711, 1000, inf,
+        -700, -708, -720, -744, -745, -745.2, -746, -747, -1000, -inf,
+        8 * 88.7, 8 * 88.8, 8 * 89.5, 8 * -87.5, 8 * -103.5, 8 * -104.5, 8 * -110,
+        nan, -nan
+    };
+
+    SECTION("double")
+    {
+        std::vector<double> values = args;
+        cxx::ziggurat_detail::exp_block(values.data(), values.size());
+
+        for (std::size_t i = 0; i < args.size(); i++) {
+            auto const expected = std::exp(args[i]);
+
+            if (std::isnan(expected)) {
+                CHECK(std::isnan(values[i]));
+            } else if (std::isinf(expected) || expected == 0) {
+                CHECK(values[i] == expected);
+            } else {
+                CHECK(values[i] == Approx(expected).epsilon(1e-15).margin(5e-324));
+            }
+        }
+    }
+
+    SECTION("float")
+    {
+        std::vector<float> float_args;
+        for (double x : args) {
+            float_args.push_back(float(x / 8));
+        }
+        std::vector<float> values = float_args;
+        cxx::ziggurat_detail::exp_block(values.data(), values.size());
+
+        for (std::size_t i = 0; i < args.size(); i++) {
+            auto const expected = std::exp(float_args[i]);
+
+            if (std::isnan(expected)) {
+                CHECK(std::isnan(values[i]));
+            } else if (std::isinf(expected) || expected == 0) {
+                CHECK(values[i] == expected);
+            } else {
+                CHECK(values[i] == Approx(expected).epsilon(1e-6).margin(1.5e-45));
+            }
+        }
+    }
+}
+
+TEST_CASE("ziggurat_lognormal_distribution - holds parameters")
+{
+    cxx::ziggurat_lognormal_distribution<double> const default_dist;
+    CHECK(default_dist.m() == 0);
+    CHECK(default_dist.s() == 1);
+
+    cxx::ziggurat_lognormal_distribution<double> dist{0.5, 0.25};
+    CHECK(dist.m() == 0.5);
+    CHECK(dist.s() == 0.25);
+    CHECK(dist.min() == 0);
+    CHECK(dist.max() == std::numeric_limits<double>::infinity());
+    CHECK(dist != default_dist);
+
+    dist.param(default_dist.param());
+    CHECK(dist == default_dist);
+}
+
+TEST_CASE("ziggurat_lognormal_distribution - generates lognormally distributed numbers")
+{
+    constexpr std::size_t sample_count = 5000;
+    double const m = 0.3;
+    double const s = 0.7;
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    std::mt19937_64 random;
+    cxx::ziggurat_lognormal_distribution<double> lognormal{m, s};
+
+    std::vector<double> scalar_samples;
+    std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+        return lognormal(random);
+    });
+    CHECK(lognormal_ks_statistic(scalar_samples, m, s) < critical_value);
+
+    std::vector<double> bulk_samples(sample_count);
+    lognormal.generate(bulk_samples.begin(), bulk_samples.end(), random);
+    CHECK(lognormal_ks_statistic(bulk_samples, m, s) < critical_value);
+}
+
+TEST_CASE("ziggurat_lognormal_distribution::generate - is exp of bulk normals")
+{
+    std::mt19937 random_1;
+    std::mt19937 random_2;
+
+    cxx::ziggurat_lognormal_distribution<float> lognormal;
+    cxx::ziggurat_lognormal_distribution<float>::param_type const param{1.0F, 0.5F};
+    std::vector<float> actual(300);
+    lognormal.generate(actual.begin(), actual.end(), random_1, param);
+
+    cxx::ziggurat_normal_distribution<float> normal{1.0F, 0.5F};
+    std::vector<float> expected(300);
+    normal.generate(expected.begin(), expected.end(), random_2);
+
+    double max_error = 0;
+    for (std::size_t i = 0; i < actual.size(); i++) {
+        max_error = std::max(max_error, std::fabs(double(actual[i]) / std::exp(double(expected[i])) - 1));
+    }
+    CHECK(max_error < 1e-6);
+}
+
+TEST_CASE("ziggurat_lognormal_distribution - is serializable and deserializable")
+{
+    cxx::ziggurat_lognormal_distribution<double> dist_1{1.2, 3.4};
+    cxx::ziggurat_lognormal_distribution<double> dist_2;
+
+    std::stringstream stream;
+    stream << dist_1;
+    stream >> dist_2;
+
+    CHECK(dist_2 == dist_1);
+}
+
+TEST_CASE("ziggurat_lognormal_distribution::generate - agrees with operator() at range edges")
+{
+    // A wide s pushes many arguments past the overflow and underflow limits
+    // of exp, where both generate and operator() give infinity and zero.
+    SECTION("float")
+    {
+        check_range_edges<float>(80);
+    }
+
+    SECTION("double")
+    {
+        check_range_edges<double>(600);
+    }
+}
@@ -0,0 +1,153 @@
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <ziggurat_multivariate.hpp>
+
+#include <catch.hpp>
+
+
+TEST_CASE("multivariate_normal - factors covariance matrix")
+{
+    std::vector<double> const mean = {1, 2, 3};
+    std::vector<double> const covariance = {
+        4, 2, 0.4,
+        2, 5, 1,
+        0.4, 1, 3,
+    };
+    cxx::multivariate_normal<double> mvn{mean, covariance};
+
+    CHECK(mvn.dimension() == 3);
+    CHECK(mvn.mean() == mean);
+
+    auto const& L = mvn.cholesky_factor();
+    for (std::size_t i = 0; i < 3; i++) {
+        for (std::size_t j = 0; j < 3; j++) {
+            double product = 0;
+            for (std::size_t k = 0; k < 3; k++) {
+                product += L[i * 3 + k] * L[j * 3 + k];
+            }
+            CHECK(product == Approx(covariance[i * 3 + j]));
+        }
+        for (std::size_t j = i + 1; j < 3; j++) {
+            CHECK(L[i * 3 + j] == 0);
+        }
+    }
+}
+
+TEST_CASE("multivariate_normal - rejects invalid covariance matrix")
+{
+    CHECK_THROWS_AS(
+        (cxx::multivariate_normal<double>{{0, 0}, {1, 0, 0}}),
+        std::invalid_argument
+    );
+    CHECK_THROWS_AS(
+        (cxx::multivariate_normal<double>{{0, 0}, {1, 2, 2, 1}}),
+        std::domain_error
+    );
+}
+
+TEST_CASE("multivariate_normal - generates vectors with given moments")
+{
+    std::vector<double> const mean = {1, -2, 0.5};
+    std::vector<double> const covariance = {
+        2, 0.6, -0.4,
+        0.6, 1, 0.3,
+        -0.4, 0.3, 0.5,
+    };
+    cxx::multivariate_normal<double> mvn{mean, covariance};
+
+    // Not a multiple of the block, so that the tail block is exercised.
+    std::size_t const count = mvn.block_vectors() * 800 + 123;
+    std::vector<double> samples(count * 3);
+
+    std::mt19937_64 random;
+    mvn.generate(samples.data(), count, random);
+
+    double sample_mean[3] = {};
+    for (std::size_t k = 0; k < count; k++) {
+        for (std::size_t i = 0; i < 3; i++) {
+            sample_mean[i] += samples[k * 3 + i];
+        }
+    }
+    for (std::size_t i = 0; i < 3; i++) {
+        sample_mean[i] /= double(count);
+        CHECK(sample_mean[i] == Approx(mean[i]).margin(0.02));
+    }
+
+    for (std::size_t i = 0; i < 3; i++) {
+        for (std::size_t j = 0; j < 3; j++) {
+            double sample_cov = 0;
+            for (std::size_t k = 0; k < count; k++) {
+                sample_cov += (samples[k * 3 + i] - sample_mean[i]) * (samples[k * 3 + j] - sample_mean[j]);
+            }
+            sample_cov /= double(count - 1);
+            CHECK(sample_cov == Approx(covariance[i * 3 + j]).margin(0.03));
+        }
+    }
+}
+
+TEST_CASE("multivariate_normal - applies full triangular factor")
+{
+    // Dimension larger than a vector register multiple and an odd size.
+    std::size_t const n = 70;
+
+    std::vector<double> mean(n);
+    std::vector<double> covariance(n * n);
+    for (std::size_t i = 0; i < n; i++) {
+        mean[i] = double(i);
+        for (std::size_t j = 0; j < n; j++) {
+            covariance[i * n + j] = std::pow(0.9, std::fabs(double(i) - double(j)));
+        }
+    }
+    cxx::multivariate_normal<float> mvn{
+        std::vector<float>(mean.begin(), mean.end()),
+        std::vector<float>(covariance.begin(), covariance.end())
+    };
+
+    std::size_t const count = 20000;
+    std::vector<float> samples(count * n);
+
+    std::mt19937 random;
+    mvn.generate(samples.data(), count, random);
+
+    // Check the variance of the last coordinate and its covariance with the
+    // first and a neighbor, which involve the whole row of the factor.
+    double sum_last = 0;
+    double sum_last2 = 0;
+    double sum_first_last = 0;
+    double sum_near_last = 0;
+    for (std::size_t k = 0; k < count; k++) {
+        auto const first = samples[k * n] - mean[0];
+        auto const near = samples[k * n + n - 2] - mean[n - 2];
+        auto const last = samples[k * n + n - 1] - mean[n - 1];
+        sum_last += last;
+        sum_last2 += last * last;
+        sum_first_last += first * last;
+        sum_near_last += near * last;
+    }
+
+    CHECK(sum_last / double(count) == Approx(0).margin(0.03));
+    CHECK(sum_last2 / double(count) == Approx(1).margin(0.04));
+    CHECK(sum_first_last / double(count) == Approx(std::pow(0.9, double(n - 1))).margin(0.03));
+    CHECK(sum_near_last / double(count) == Approx(0.9).margin(0.04));
+}
+
+TEST_CASE("multivariate_normal - output does not depend on block-aligned splits")
+{
+    cxx::multivariate_normal<double> mvn{{0, 0}, {1, 0.5, 0.5, 1}};
+    auto const block = mvn.block_vectors();
+
+    std::mt19937_64 random_1;
+    std::vector<double> whole(4 * block * 2);
+    mvn.generate(whole.data(), 4 * block, random_1);
+
+    std::mt19937_64 random_2;
+    std::vector<double> split(4 * block * 2);
+    mvn.generate(split.data(), block, random_2);
+    mvn.generate(split.data() + block * 2, 3 * block, random_2);
+
+    CHECK(whole == split);
+}
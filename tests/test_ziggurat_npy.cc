@@ -0,0 +1,108 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_npy.hpp>
+#include <ziggurat_parallel.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    // temporary_file removes the file at a path on destruction.
+    struct temporary_file
+    {
+        std::string path;
+
+        explicit temporary_file(std::string const& p)
+            : path{p}
+        {
+        }
+
+        ~temporary_file()
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+    std::string read_file(std::string const& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+}
+
+TEST_CASE("make_npy_header - creates aligned version 1.0 header")
+{
+    auto const header = cxx::ziggurat_detail::make_npy_header("<f8", {3, 4});
+
+    CHECK(header.size() % 64 == 0);
+    CHECK(header.substr(0, 8) == std::string("\x93NUMPY\x01\x00", 8));
+    CHECK(header.find("{'descr': '<f8', 'fortran_order': False, 'shape': (3, 4), }") == 10);
+    CHECK(header.back() == '\n');
+
+    auto const header_len = std::size_t(std::uint8_t(header[8])) | std::size_t(std::uint8_t(header[9])) << 8;
+    CHECK(header_len == header.size() - 10);
+}
+
+TEST_CASE("make_npy_header - formats one-dimensional shape as tuple")
+{
+    auto const header = cxx::ziggurat_detail::make_npy_header("<f4", {10});
+    CHECK(header.find("'shape': (10,), }") != std::string::npos);
+}
+
+TEST_CASE("make_npy_header - switches to version 2.0 for long header")
+{
+    std::vector<std::uint64_t> const shape(30000, 1);
+    auto const header = cxx::ziggurat_detail::make_npy_header("<f4", shape);
+
+    CHECK(header.size() % 64 == 0);
+    CHECK(header[6] == 2);
+    CHECK(header.back() == '\n');
+}
+
+TEST_CASE("write_normal_npy - writes parallel_generate sequence")
+{
+    temporary_file const file{"test_normal_npy.tmp"};
+
+    // Spans multiple chunks with a partial last chunk.
+    std::uint64_t const rows = 3;
+    std::uint64_t const cols = 500000;
+    cxx::write_normal_npy<float>(file.path, {rows, cols}, 123);
+
+    std::vector<float> expected(rows * cols);
+    cxx::parallel_generate(expected.begin(), expected.end(), 123);
+
+    auto const content = read_file(file.path);
+    auto const header = cxx::ziggurat_detail::make_npy_header("<f4", {rows, cols});
+    REQUIRE(content.size() == header.size() + expected.size() * sizeof(float));
+    CHECK(content.compare(0, header.size(), header) == 0);
+
+    std::vector<float> actual(expected.size());
+    std::memcpy(actual.data(), content.data() + header.size(), actual.size() * sizeof(float));
+    CHECK(actual == expected);
+}
+
+TEST_CASE("npy_writer - checks number of written elements")
+{
+    temporary_file const file{"test_npy_writer.tmp"};
+    double const data[4] = {};
+
+    cxx::npy_writer<double> writer{file.path, {3}};
+    CHECK_THROWS_AS(writer.write(data, 4), std::length_error);
+    writer.write(data, 2);
+    CHECK_THROWS_AS(writer.close(), std::length_error);
+    writer.write(data, 1);
+    writer.close();
+
+    auto const header = cxx::ziggurat_detail::make_npy_header("<f8", {3});
+    CHECK(read_file(file.path).size() == header.size() + 3 * sizeof(double));
+}
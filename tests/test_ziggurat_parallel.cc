@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_parallel.hpp>
+
+#include <catch.hpp>
+
+
+TEST_CASE("ziggurat_normal_distribution::generate - fills range with normal numbers")
+{
+    std::mt19937_64 random;
+    cxx::ziggurat_normal_distribution<double> normal{1.2, 3.4};
+
+    std::vector<double> samples(10000);
+    normal.generate(samples.begin(), samples.end(), random);
+
+    double mean = 0;
+    double var = 0;
+    for (double x : samples) {
+        mean += x;
+    }
+    mean /= double(samples.size());
+
+    for (double x : samples) {
+        var += (x - mean) * (x - mean);
+    }
+    var /= double(samples.size());
+
+    CHECK(mean == Approx(1.2).margin(0.1));
+    CHECK(std::sqrt(var) == Approx(3.4).epsilon(0.05));
+}
+
+TEST_CASE("ziggurat_normal_distribution::generate - generates normally distributed numbers")
+{
+    std::mt19937_64 random;
+    cxx::ziggurat_normal_distribution<double> normal;
+
+    constexpr int sample_count = 5000;
+
+    std::vector<double> samples(sample_count);
+    normal.generate(samples.begin(), samples.end(), random);
+    std::sort(samples.begin(), samples.end());
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    double D = 0;
+    int rank = 0;
+
+    for (double x : samples) {
+        rank++;
+
+        double const sample_cdf = rank / double(sample_count);
+        double const normal_cdf = 1 - std::erfc(x / std::sqrt(2)) / 2;
+
+        D = std::max(D, std::fabs(sample_cdf - normal_cdf));
+    }
+
+    CHECK(D < critical_value);
+}
+
+TEST_CASE("ziggurat_normal_distribution::generate - accepts 32-bit engine")
+{
+    std::mt19937 random;
+    cxx::ziggurat_normal_distribution<float> normal;
+
+    std::vector<float> samples(1000);
+    normal.generate(samples.begin(), samples.end(), random);
+
+    for (float x : samples) {
+        CHECK(x == x);
+    }
+}
+
+TEST_CASE("parallel_generate - is independent of thread count")
+{
+    // Not a multiple of the block size.
+    constexpr std::size_t size = 100000;
+
+    std::vector<double> samples_1(size);
+    std::vector<double> samples_3(size);
+    std::vector<double> samples_8(size);
+
+    cxx::parallel_generate(samples_1.begin(), samples_1.end(), 123, 1);
+    cxx::parallel_generate(samples_3.begin(), samples_3.end(), 123, 3);
+    cxx::parallel_generate(samples_8.begin(), samples_8.end(), 123, 8);
+
+    CHECK(samples_1 == samples_3);
+    CHECK(samples_1 == samples_8);
+}
+
+TEST_CASE("parallel_generate - depends on seed")
+{
+    std::vector<double> samples_1(1000);
+    std::vector<double> samples_2(1000);
+
+    cxx::parallel_generate(samples_1.begin(), samples_1.end(), 1);
+    cxx::parallel_generate(samples_2.begin(), samples_2.end(), 2);
+
+    CHECK(samples_1 != samples_2);
+}
+
+TEST_CASE("parallel_generate - uses given parameters")
+{
+    std::vector<float> samples(100000);
+    cxx::ziggurat_normal_distribution<float>::param_type param{5.6F, 0.1F};
+
+    cxx::parallel_generate<std::mt19937>(samples.begin(), samples.end(), 42, param, 4);
+
+    double mean = 0;
+    for (float x : samples) {
+        mean += x;
+    }
+    mean /= double(samples.size());
+
+    CHECK(mean == Approx(5.6).margin(0.01));
+}
+
+TEST_CASE("parallel_generate - accepts empty range")
+{
+    std::vector<double> samples;
+    cxx::parallel_generate(samples.begin(), samples.end(), 1);
+}
+
+TEST_CASE("thread_normal - generates normal numbers")
+{
+    constexpr int sample_count = 10000;
+    double mean = 0;
+    double var = 0;
+
+    for (int i = 0; i < sample_count; i++) {
+        double const x = cxx::thread_normal<double>();
+        mean += x;
+        var += x * x;
+    }
+    mean /= sample_count;
+    var /= sample_count;
+
+    CHECK(mean == Approx(0).margin(0.05));
+    CHECK(var == Approx(1).epsilon(0.05));
+}
+
+TEST_CASE("thread_normal - uses given parameters")
+{
+    cxx::ziggurat_normal_distribution<float>::param_type param{5.6F, 0.1F};
+
+    constexpr int sample_count = 1000;
+    double mean = 0;
+
+    for (int i = 0; i < sample_count; i++) {
+        mean += cxx::thread_normal<float>(param);
+    }
+    mean /= sample_count;
+
+    CHECK(mean == Approx(5.6).margin(0.01));
+}
+
+TEST_CASE("thread_normal - uses distinct streams in distinct threads")
+{
+    std::vector<double> samples_1(100);
+    std::vector<double> samples_2(100);
+
+    auto fill = [](std::vector<double>& samples) {
+        for (double& x : samples) {
+            x = cxx::thread_normal<double>();
+        }
+    };
+
+    std::thread thread_1{fill, std::ref(samples_1)};
+    std::thread thread_2{fill, std::ref(samples_2)};
+    thread_1.join();
+    thread_2.join();
+
+    CHECK(samples_1 != samples_2);
+}
+
+TEST_CASE("numa_partition - splits range proportionally to CPU count")
+{
+    constexpr std::size_t block_size = cxx::ziggurat_detail::parallel_block_size;
+
+    cxx::numa_topology topology;
+    topology.nodes.resize(2);
+    topology.nodes[0].cpus = {0, 1, 2};
+    topology.nodes[1].cpus = {3};
+
+    auto const ranges = cxx::numa_partition(8 * block_size + 1, topology);
+
+    REQUIRE(ranges.size() == 2);
+    CHECK(ranges[0].first == 0);
+    CHECK(ranges[0].second == 6 * block_size);
+    CHECK(ranges[1].first == 6 * block_size);
+    CHECK(ranges[1].second == 8 * block_size + 1);
+}
+
+TEST_CASE("numa_parallel_generate - is identical to parallel_generate")
+{
+    constexpr std::size_t size = 100000;
+
+    // Simulated topology without binding.
+    cxx::numa_topology topology;
+    topology.nodes.resize(3);
+
+    std::vector<double> expected(size);
+    std::vector<double> samples(size);
+
+    cxx::parallel_generate(expected.begin(), expected.end(), 123);
+    cxx::numa_parallel_generate(samples.begin(), samples.end(), 123, topology);
+
+    CHECK(samples == expected);
+}
+
+TEST_CASE("numa_parallel_generate - works with detected topology")
+{
+    std::vector<float> expected(50000);
+    std::vector<float> samples(50000);
+
+    cxx::parallel_generate(expected.begin(), expected.end(), 1);
+    cxx::numa_parallel_generate(samples.begin(), samples.end(), 1);
+
+    CHECK(samples == expected);
+}
+
+TEST_CASE("detect_numa_topology - returns at least one node")
+{
+    auto const topology = cxx::detect_numa_topology();
+    CHECK_FALSE(topology.nodes.empty());
+}
+
+TEST_CASE("parse_cpu_list - parses ranges")
+{
+    auto const cpus = cxx::ziggurat_detail::parse_cpu_list("0-2,5,8-9\n");
+    CHECK(cpus == (std::vector<int>{0, 1, 2, 5, 8, 9}));
+}
+
+TEST_CASE("chase_lev_deque - pops in LIFO order and steals in FIFO order")
+{
+    cxx::ziggurat_detail::chase_lev_deque<int> deque{2};
+    int items[5] = {0, 1, 2, 3, 4};
+
+    // Exceeds initial capacity.
+    for (int& item : items) {
+        deque.push(&item);
+    }
+
+    CHECK(deque.steal() == &items[0]);
+    CHECK(deque.pop() == &items[4]);
+    CHECK(deque.steal() == &items[1]);
+    CHECK(deque.pop() == &items[3]);
+    CHECK(deque.pop() == &items[2]);
+    CHECK(deque.pop() == nullptr);
+    CHECK(deque.steal() == nullptr);
+}
+
+TEST_CASE("parallel_generate - fills batch of requests independently of thread count")
+{
+    constexpr std::size_t block_size = cxx::ziggurat_detail::parallel_block_size;
+
+    // Mix of tiny, empty and multi-block requests.
+    std::vector<std::size_t> const sizes = {
+        1, 252, 0, 10 * block_size + 7, 1000, block_size, 3
+    };
+
+    auto fill = [&](std::size_t thread_count) {
+        std::vector<std::vector<double>> arrays;
+        std::vector<cxx::generate_request<double>> requests;
+
+        for (auto size : sizes) {
+            arrays.emplace_back(size);
+        }
+        for (auto& array : arrays) {
+            requests.emplace_back(array.data(), array.data() + array.size());
+        }
+        cxx::parallel_generate(requests, 123, thread_count);
+
+        return arrays;
+    };
+
+    auto const arrays_1 = fill(1);
+    auto const arrays_4 = fill(4);
+
+    CHECK(arrays_1 == arrays_4);
+    CHECK(arrays_1[0] != arrays_1[6]);
+}
+
+TEST_CASE("parallel_generate - uses parameters of each request")
+{
+    std::vector<double> array_1(50000);
+    std::vector<double> array_2(50000);
+
+    cxx::ziggurat_normal_distribution<double>::param_type param_1{1.0, 0.1};
+    cxx::ziggurat_normal_distribution<double>::param_type param_2{-5.0, 0.1};
+
+    std::vector<cxx::generate_request<double>> requests;
+    requests.emplace_back(array_1.data(), array_1.data() + array_1.size(), param_1);
+    requests.emplace_back(array_2.data(), array_2.data() + array_2.size(), param_2);
+
+    cxx::parallel_generate(requests, 1, 3);
+
+    double mean_1 = 0;
+    double mean_2 = 0;
+    for (std::size_t i = 0; i < array_1.size(); i++) {
+        mean_1 += array_1[i];
+        mean_2 += array_2[i];
+    }
+    mean_1 /= double(array_1.size());
+    mean_2 /= double(array_2.size());
+
+    CHECK(mean_1 == Approx(1.0).margin(0.01));
+    CHECK(mean_2 == Approx(-5.0).margin(0.01));
+}
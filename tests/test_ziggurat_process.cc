@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <ziggurat_process.hpp>
+
+#include <catch.hpp>
+
+
+TEST_CASE("gbm_path_generator - reports path shape")
+{
+    cxx::gbm_path_generator<double> const gbm{100, 0.05, 0.2, 1.0 / 252, 252};
+
+    CHECK(gbm.step_count() == 252);
+    CHECK(gbm.point_count() == 253);
+    CHECK(gbm.layout() == cxx::path_layout::path_major);
+}
+
+TEST_CASE("gbm_path_generator - generates paths with correct statistics")
+{
+    double const s0 = 100;
+    double const mu = 0.1;
+    double const sigma = 0.3;
+    std::size_t const step_count = 50;
+    double const dt = 1.0 / step_count;
+    std::size_t const path_count = 20000;
+
+    for (auto const layout : {cxx::path_layout::path_major, cxx::path_layout::step_major}) {
+        std::mt19937_64 random;
+        cxx::gbm_path_generator<double> gbm{s0, mu, sigma, dt, step_count, layout};
+
+        std::vector<double> paths(path_count * gbm.point_count());
+        gbm.generate(paths.data(), path_count, random);
+
+        auto point = [&](std::size_t p, std::size_t t) {
+            return layout == cxx::path_layout::path_major
+                ? paths[p * gbm.point_count() + t]
+                : paths[t * path_count + p];
+        };
+
+        std::size_t start_mismatches = 0;
+        double final_mean = 0;
+        double log_mean = 0;
+        double log_var = 0;
+
+        for (std::size_t p = 0; p < path_count; p++) {
+            start_mismatches += point(p, 0) != s0;
+
+            auto const log_return = std::log(point(p, step_count) / s0);
+            final_mean += point(p, step_count);
+            log_mean += log_return;
+            log_var += log_return * log_return;
+        }
+        CHECK(start_mismatches == 0);
+
+        final_mean /= double(path_count);
+        log_mean /= double(path_count);
+        log_var = log_var / double(path_count) - log_mean * log_mean;
+
+        // E[S_T] = S_0 exp(mu T) and log(S_T / S_0) ~ N((mu - sigma^2/2) T, sigma^2 T).
+        CHECK(final_mean == Approx(s0 * std::exp(mu)).epsilon(0.01));
+        CHECK(log_mean == Approx(mu - sigma * sigma / 2).margin(0.01));
+        CHECK(log_var == Approx(sigma * sigma).epsilon(0.03));
+    }
+}
+
+TEST_CASE("gbm_path_generator - increments of path are independent")
+{
+    std::mt19937_64 random;
+    cxx::gbm_path_generator<float> gbm{1.0F, 0.0F, 1.0F, 0.01F, 200};
+
+    std::vector<float> paths(500 * gbm.point_count());
+    gbm.generate(paths.data(), 500, random);
+
+    // Lag-1 autocorrelation of log-increments.
+    double sum_xy = 0;
+    double sum_xx = 0;
+    for (std::size_t p = 0; p < 500; p++) {
+        auto const path = paths.data() + p * gbm.point_count();
+        for (std::size_t t = 2; t < gbm.point_count(); t++) {
+            double const x = std::log(path[t - 1] / path[t - 2]);
+            double const y = std::log(path[t] / path[t - 1]);
+            sum_xy += x * y;
+            sum_xx += x * x;
+        }
+    }
+
+    CHECK(sum_xy / sum_xx == Approx(0).margin(0.02));
+}
+
+TEST_CASE("brownian_path_generator - validates time grid")
+{
+    cxx::brownian_path_generator<double> const brownian{{0.5, 1, 2}};
+
+    CHECK(brownian.point_count() == 3);
+    CHECK(brownian.times() == std::vector<double>{0.5, 1, 2});
+    CHECK(brownian.construction() == cxx::brownian_construction::incremental);
+
+    CHECK_THROWS_AS(cxx::brownian_path_generator<double>{std::vector<double>{}}, std::invalid_argument);
+    CHECK_THROWS_AS((cxx::brownian_path_generator<double>{{-1, 1}}), std::invalid_argument);
+    CHECK_THROWS_AS((cxx::brownian_path_generator<double>{{1, 1}}), std::invalid_argument);
+}
+
+TEST_CASE("brownian_path_generator - generates paths with Brownian covariance")
+{
+    // Non-uniform grid starting at zero with a point count that is not a
+    // power of two.
+    std::vector<double> const times = {0, 0.1, 0.25, 0.3, 0.7, 1, 1.6, 1.65, 3};
+    std::size_t const path_count = 20000;
+
+    for (auto const construction : {cxx::brownian_construction::incremental, cxx::brownian_construction::bridge}) {
+        std::mt19937_64 random;
+        cxx::brownian_path_generator<double> brownian{times, construction};
+
+        std::vector<double> paths(path_count * times.size());
+        brownian.generate(paths.data(), path_count, random);
+
+        auto const n = times.size();
+        double max_mean_error = 0;
+        double max_cov_error = 0;
+
+        for (std::size_t i = 0; i < n; i++) {
+            auto const row_i = paths.data() + i * path_count;
+
+            double mean = 0;
+            for (std::size_t p = 0; p < path_count; p++) {
+                mean += row_i[p];
+            }
+            mean /= double(path_count);
+
+            auto const mean_se = std::sqrt(times[i] / double(path_count));
+            max_mean_error = std::max(max_mean_error, std::fabs(mean) - 4 * mean_se);
+
+            for (std::size_t j = 0; j <= i; j++) {
+                auto const row_j = paths.data() + j * path_count;
+
+                double cov = 0;
+                for (std::size_t p = 0; p < path_count; p++) {
+                    cov += row_i[p] * row_j[p];
+                }
+                cov /= double(path_count);
+
+                // Cov(W(s), W(t)) = min(s, t) and the standard error of the
+                // sample covariance of normals is sqrt((st + min(s, t)^2) / n).
+                auto const expected = times[j];
+                auto const cov_se = std::sqrt((times[i] * times[j] + expected * expected) / double(path_count));
+                max_cov_error = std::max(max_cov_error, std::fabs(cov - expected) - 4 * cov_se);
+            }
+        }
+
+        CHECK(max_mean_error <= 0);
+        CHECK(max_cov_error <= 0);
+    }
+}
+
+TEST_CASE("brownian_path_generator - bridge consumes normals coarse to fine")
+{
+    std::vector<double> const times = {0.5, 1, 2, 2.5, 4};
+    cxx::brownian_path_generator<double> const bridge{times, cxx::brownian_construction::bridge};
+    cxx::brownian_path_generator<double> const incremental{times};
+
+    // A single path whose first normal number is one and others are zero.
+    // The bridge puts the endpoint at sqrt(T) and interpolates linearly in
+    // time, and the incremental construction moves only the first point.
+    std::vector<double> normals(times.size());
+    normals[0] = 1;
+
+    std::vector<double> bridge_path(times.size());
+    std::vector<double> incremental_path(times.size());
+    bridge.transform(normals.data(), bridge_path.data(), 1);
+    incremental.transform(normals.data(), incremental_path.data(), 1);
+
+    for (std::size_t k = 0; k < times.size(); k++) {
+        CHECK(bridge_path[k] == Approx(times[k] / 4 * 2));
+        CHECK(incremental_path[k] == Approx(std::sqrt(0.5)));
+    }
+}
+
+TEST_CASE("brownian_path_generator - transforms normals of many paths")
+{
+    std::vector<double> const times = {0.2, 0.5, 0.9, 1.4};
+    std::size_t const path_count = 3;
+
+    cxx::brownian_path_generator<double> const incremental{times};
+
+    std::vector<double> normals(times.size() * path_count);
+    for (std::size_t i = 0; i < normals.size(); i++) {
+        normals[i] = double(i % 5) - 2;
+    }
+
+    std::vector<double> paths(normals.size());
+    incremental.transform(normals.data(), paths.data(), path_count);
+
+    for (std::size_t p = 0; p < path_count; p++) {
+        double expected = 0;
+        double prev_time = 0;
+        for (std::size_t k = 0; k < times.size(); k++) {
+            expected += std::sqrt(times[k] - prev_time) * normals[k * path_count + p];
+            prev_time = times[k];
+            CHECK(paths[k * path_count + p] == Approx(expected));
+        }
+    }
+}
+
+TEST_CASE("ou_stepper - computes exact transition coefficients")
+{
+    cxx::ou_stepper<double> const ou{2, 0.5, 0.1, 1.5};
+
+    CHECK(ou.theta() == 2);
+    CHECK(ou.sigma() == 0.5);
+    CHECK(ou.dt() == 0.1);
+    CHECK(ou.mu() == 1.5);
+    CHECK(ou.decay() == Approx(std::exp(-0.2)));
+    CHECK(ou.noise_scale() == Approx(0.5 * std::sqrt((1 - std::exp(-0.4)) / 4)));
+
+    // theta = 0 is Brownian motion.
+    cxx::ou_stepper<double> const brownian{0, 0.5, 0.1};
+    CHECK(brownian.decay() == 1);
+    CHECK(brownian.noise_scale() == Approx(0.5 * std::sqrt(0.1)));
+}
+
+TEST_CASE("ou_stepper - samples exact transition of a large step")
+{
+    double const theta = 1.5;
+    double const sigma = 0.8;
+    double const dt = 0.7;
+    double const mu = -1;
+    double const x0 = 3;
+
+    // Not a multiple of the block size.
+    std::size_t const count = 50001;
+
+    std::mt19937_64 random;
+    cxx::ou_stepper<double> ou{theta, sigma, dt, mu};
+
+    std::vector<double> state(count, x0);
+    ou.step(state.data(), count, random);
+
+    double mean = 0;
+    double var = 0;
+    for (double x : state) {
+        mean += x;
+    }
+    mean /= double(count);
+    for (double x : state) {
+        var += (x - mean) * (x - mean);
+    }
+    var /= double(count);
+
+    auto const expected_mean = mu + (x0 - mu) * std::exp(-theta * dt);
+    auto const expected_var = sigma * sigma * (1 - std::exp(-2 * theta * dt)) / (2 * theta);
+
+    CHECK(mean == Approx(expected_mean).margin(4 * std::sqrt(expected_var / double(count))));
+    CHECK(var == Approx(expected_var).epsilon(0.03));
+}
+
+TEST_CASE("ou_stepper - reaches stationary distribution")
+{
+    float const theta = 2;
+    float const sigma = 0.6F;
+    float const mu = 0.5F;
+    std::size_t const count = 20000;
+
+    std::mt19937 random;
+    cxx::ou_stepper<float> ou{theta, sigma, 0.05F, mu};
+
+    // exp(-theta * 200 * dt) = exp(-20) forgets the initial state.
+    std::vector<float> state(count, 10.0F);
+    ou.step(state.data(), count, 200, random);
+
+    double mean = 0;
+    double var = 0;
+    for (float x : state) {
+        mean += x;
+    }
+    mean /= double(count);
+    for (float x : state) {
+        var += (x - mean) * (x - mean);
+    }
+    var /= double(count);
+
+    auto const stationary_var = double(sigma * sigma / (2 * theta));
+
+    CHECK(mean == Approx(mu).margin(4 * std::sqrt(stationary_var / double(count))));
+    CHECK(var == Approx(stationary_var).epsilon(0.04));
+}
+
+TEST_CASE("ou_stepper - does not depend on block-aligned splits")
+{
+    cxx::ou_stepper<double> ou{1, 1, 0.1};
+
+    std::vector<double> whole(300, 1.0);
+    std::vector<double> split(300, 1.0);
+
+    std::mt19937_64 random_1{7};
+    ou.step(whole.data(), whole.size(), random_1);
+
+    std::mt19937_64 random_2{7};
+    ou.step(split.data(), 256, random_2);
+    ou.step(split.data() + 256, 44, random_2);
+
+    CHECK(whole == split);
+}
+
+TEST_CASE("ou_stepper - advances fewer processes than a block")
+{
+    cxx::ou_stepper<double> ou{1.5, 0.8, 0.2, -1};
+
+    std::vector<double> state(10, 2.0);
+
+    std::mt19937_64 random;
+    std::mt19937_64 expected_random = random;
+    ou.step(state.data(), state.size(), random);
+
+    std::vector<double> noise(state.size());
+    cxx::ziggurat_normal_distribution<double> normal;
+    normal.generate(noise.begin(), noise.end(), expected_random);
+
+    for (std::size_t i = 0; i < state.size(); i++) {
+        auto const expected = ou.mu() + ou.decay() * (2.0 - ou.mu()) + ou.noise_scale() * noise[i];
+        CHECK(state[i] == Approx(expected));
+    }
+}
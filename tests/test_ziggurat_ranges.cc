@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <ziggurat.hpp>
+#include <ziggurat_ranges.hpp>
+
+#include <catch.hpp>
+
+
+#if defined(ZIGGURAT_HAS_RANGES)
+
+TEST_CASE("normal_view - models an input view")
+{
+    using view = cxx::normal_view<std::mt19937_64>;
+
+    CHECK(std::ranges::input_range<view>);
+    CHECK(std::ranges::view<view>);
+}
+
+TEST_CASE("normal_view - is equivalent to bulk generation")
+{
+    std::mt19937_64 engine_1;
+    std::mt19937_64 engine_2;
+
+    std::vector<double> expected(1024);
+    cxx::ziggurat_normal_distribution<double> normal;
+    normal.generate(expected.begin(), expected.end(), engine_1);
+
+    std::vector<double> actual;
+    for (double z : cxx::normal_view(engine_2) | std::views::take(expected.size())) {
+        actual.push_back(z);
+    }
+
+    CHECK(actual == expected);
+}
+
+TEST_CASE("normal_view - applies parameters")
+{
+    std::mt19937 engine;
+    cxx::ziggurat_normal_distribution<float>::param_type const param{-2.0f, 0.5f};
+
+    float mean = 0;
+    std::size_t count = 0;
+    for (float z : cxx::normal_view<std::mt19937, float>(engine, param) | std::views::take(10000)) {
+        mean += z;
+        count++;
+    }
+    mean /= float(count);
+
+    CHECK(count == 10000);
+    CHECK(mean == Approx(-2).margin(0.05));
+}
+
+#endif
+
+#if defined(ZIGGURAT_HAS_COROUTINES)
+
+TEST_CASE("generate_normals - is equivalent to bulk generation")
+{
+    std::mt19937_64 engine_1;
+    std::mt19937_64 engine_2;
+
+    std::vector<double> expected(1024);
+    cxx::ziggurat_normal_distribution<double> normal;
+    normal.generate(expected.begin(), expected.end(), engine_1);
+
+    std::vector<double> actual;
+    for (double z : cxx::generate_normals(engine_2, {}, expected.size())) {
+        actual.push_back(z);
+    }
+
+    CHECK(actual == expected);
+}
+
+TEST_CASE("generate_normals - stops after given count")
+{
+    std::mt19937_64 engine;
+
+    std::size_t count = 0;
+    for (double z : cxx::generate_normals(engine, {}, 300)) {
+        (void) z;
+        count++;
+    }
+
+    CHECK(count == 300);
+}
+
+TEST_CASE("generate_normals - is unbounded by default")
+{
+    std::mt19937_64 engine;
+
+    std::size_t count = 0;
+    for (double z : cxx::generate_normals(engine)) {
+        (void) z;
+        if (++count == 1000) {
+            break;
+        }
+    }
+
+    CHECK(count == 1000);
+}
+
+#endif
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <ziggurat_sphere.hpp>
+
+#include <catch.hpp>
+
+
+TEST_CASE("rsqrt_kernel - is accurate")
+{
+    std::mt19937_64 random;
+    std::uniform_real_distribution<double> exponent{-30, 30};
+
+    double values[cxx::ziggurat_detail::bulk_block_size];
+    float float_values[cxx::ziggurat_detail::bulk_block_size];
+    for (std::size_t i = 0; i < cxx::ziggurat_detail::bulk_block_size; i++) {
+        values[i] = std::exp(exponent(random));
+        float_values[i] = float(values[i]);
+    }
+
+    double args[cxx::ziggurat_detail::bulk_block_size];
+    std::copy(std::begin(values), std::end(values), args);
+    cxx::ziggurat_detail::rsqrt_kernel(values);
+    cxx::ziggurat_detail::rsqrt_kernel(float_values);
+
+    double max_error = 0;
+    double max_float_error = 0;
+    for (std::size_t i = 0; i < cxx::ziggurat_detail::bulk_block_size; i++) {
+        auto const expected = 1 / std::sqrt(args[i]);
+        max_error = std::max(max_error, std::fabs(values[i] / expected - 1));
+        max_float_error = std::max(max_float_error, std::fabs(float_values[i] / expected - 1));
+    }
+    CHECK(max_error < 1e-15);
+    CHECK(max_float_error < 3e-7);
+}
+
+TEST_CASE("unit_vector_generator - generates unit vectors")
+{
+    std::mt19937_64 random;
+
+    for (std::size_t n : {std::size_t(2), std::size_t(3), std::size_t(10)}) {
+        for (auto layout : {cxx::vector_layout::interleaved, cxx::vector_layout::planar}) {
+            cxx::unit_vector_generator<double> generator{n, layout};
+            CHECK(generator.dimension() == n);
+            CHECK(generator.layout() == layout);
+
+            // Not a multiple of the block size.
+            std::size_t const count = 1000;
+            std::vector<double> vectors(count * n);
+            generator.generate(vectors.data(), count, random);
+
+            auto coordinate = [&](std::size_t k, std::size_t d) {
+                return layout == cxx::vector_layout::interleaved
+                    ? vectors[k * n + d]
+                    : vectors[d * count + k];
+            };
+
+            double max_error = 0;
+            for (std::size_t k = 0; k < count; k++) {
+                double norm2 = 0;
+                for (std::size_t d = 0; d < n; d++) {
+                    norm2 += coordinate(k, d) * coordinate(k, d);
+                }
+                max_error = std::max(max_error, std::fabs(norm2 - 1));
+            }
+            CHECK(max_error < 1e-14);
+        }
+    }
+}
+
+namespace
+{
+    // uniform_ks_statistic returns the Kolmogorov-Smirnov statistic of
+    // samples against the uniform distribution on [a, b].
+    template<typename T>
+    double uniform_ks_statistic(std::vector<T> samples, double a, double b)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        double D = 0;
+        double rank = 0;
+        for (T x : samples) {
+            rank++;
+            auto const cdf = (double(x) - a) / (b - a);
+            D = std::max(D, std::fabs(rank / double(samples.size()) - cdf));
+        }
+        return D;
+    }
+
+    template<typename T, typename URNG>
+    void check_sphere_uniformity(URNG& random)
+    {
+        cxx::unit_vector_generator<T> generator{3, cxx::vector_layout::planar};
+
+        constexpr std::size_t count = 10000;
+        std::vector<T> vectors(count * 3);
+        generator.generate(vectors.data(), count, random);
+
+        // Each coordinate of a uniform direction on the 2-sphere is uniformly
+        // distributed on [-1, 1] (Archimedes).
+        double const critical_value = 1.63 / std::sqrt(count);
+
+        for (std::size_t d = 0; d < 3; d++) {
+            std::vector<T> coords(vectors.data() + d * count, vectors.data() + (d + 1) * count);
+            CHECK(uniform_ks_statistic(coords, -1, 1) < critical_value);
+        }
+    }
+}
+
+TEST_CASE("unit_vector_generator - generates uniformly distributed directions")
+{
+    SECTION("circle")
+    {
+        std::mt19937_64 random;
+        cxx::unit_vector_generator<double> generator{2};
+
+        constexpr std::size_t count = 10000;
+        std::vector<double> vectors(count * 2);
+        generator.generate(vectors.data(), count, random);
+
+        std::vector<double> angles(count);
+        for (std::size_t k = 0; k < count; k++) {
+            angles[k] = std::atan2(vectors[k * 2 + 1], vectors[k * 2]);
+        }
+
+        double const pi = 3.14159265358979324;
+        double const critical_value = 1.63 / std::sqrt(count);
+        CHECK(uniform_ks_statistic(angles, -pi, pi) < critical_value);
+    }
+
+    SECTION("sphere with 32-bit engine")
+    {
+        std::mt19937 random{5};
+        check_sphere_uniformity<float>(random);
+        check_sphere_uniformity<double>(random);
+    }
+
+    SECTION("sphere with 64-bit engine")
+    {
+        std::mt19937_64 random;
+        check_sphere_uniformity<float>(random);
+        check_sphere_uniformity<double>(random);
+    }
+
+    SECTION("higher dimension")
+    {
+        std::mt19937_64 random;
+        cxx::unit_vector_generator<double> generator{10};
+
+        constexpr std::size_t count = 20000;
+        std::vector<double> vectors(count * 10);
+        generator.generate(vectors.data(), count, random);
+
+        // Isotropy: E[x_d] = 0 and E[x_d^2] = 1/n.
+        for (std::size_t d = 0; d < 10; d++) {
+            double mean = 0;
+            double mean_square = 0;
+            for (std::size_t k = 0; k < count; k++) {
+                mean += vectors[k * 10 + d];
+                mean_square += vectors[k * 10 + d] * vectors[k * 10 + d];
+            }
+            mean /= count;
+            mean_square /= count;
+
+            CHECK(mean == Approx(0).margin(0.01));
+            CHECK(mean_square == Approx(0.1).margin(0.005));
+        }
+    }
+}
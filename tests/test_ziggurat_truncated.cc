@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <ziggurat_truncated.hpp>
+
+#include <catch.hpp>
+
+
+namespace
+{
+    // truncated_normal_cdf is the cumulative distribution function of the
+    // normal distribution truncated to [a, b]. Upper tail probabilities are
+    // used for a positive interval to retain precision in the tail.
+    struct truncated_normal_cdf
+    {
+        double mean;
+        double stddev;
+        double a;
+        double b;
+
+        double operator()(double x) const
+        {
+            auto const z = (x - mean) / stddev;
+            auto const alpha = (a - mean) / stddev;
+            auto const beta = (b - mean) / stddev;
+
+            if (alpha > 0) {
+                return (upper(alpha) - upper(z)) / (upper(alpha) - upper(beta));
+            }
+            return (lower(z) - lower(alpha)) / (lower(beta) - lower(alpha));
+        }
+
+        static double lower(double z)
+        {
+            return std::erfc(-z / std::sqrt(2)) / 2;
+        }
+
+        static double upper(double z)
+        {
+            return std::erfc(z / std::sqrt(2)) / 2;
+        }
+    };
+
+    // ks_statistic returns the Kolmogorov-Smirnov statistic of samples
+    // against given cumulative distribution function.
+    template<typename CDF>
+    double ks_statistic(std::vector<double> samples, CDF cdf)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        double D = 0;
+        double rank = 0;
+        for (double x : samples) {
+            rank++;
+            D = std::max(D, std::fabs(rank / double(samples.size()) - cdf(x)));
+        }
+        return D;
+    }
+}
+
+TEST_CASE("ziggurat_truncated_normal_distribution - holds parameters")
+{
+    cxx::ziggurat_truncated_normal_distribution<double> const default_dist;
+    CHECK(default_dist.mean() == 0);
+    CHECK(default_dist.stddev() == 1);
+    CHECK(default_dist.a() == -std::numeric_limits<double>::infinity());
+    CHECK(default_dist.b() == std::numeric_limits<double>::infinity());
+
+    cxx::ziggurat_truncated_normal_distribution<double> dist{1, 2, 3, 4};
+    CHECK(dist.mean() == 1);
+    CHECK(dist.stddev() == 2);
+    CHECK(dist.a() == 3);
+    CHECK(dist.b() == 4);
+    CHECK(dist.min() == 3);
+    CHECK(dist.max() == 4);
+    CHECK(dist != default_dist);
+
+    dist.param(default_dist.param());
+    CHECK(dist == default_dist);
+}
+
+TEST_CASE("ziggurat_truncated_normal_distribution - generates numbers in any interval")
+{
+    double const inf = std::numeric_limits<double>::infinity();
+
+    // Each interval exercises one of the sampling strategies.
+    struct interval
+    {
+        double mean;
+        double stddev;
+        double a;
+        double b;
+    };
+    interval const intervals[] = {
+        {0, 1, -1, 2},        // normal rejection
+        {1, 2, 0, 2},         // uniform around the center
+        {0, 1, 0.2, inf},     // half-normal rejection
+        {0, 1, 3, inf},       // exponential tail
+        {-1, 0.5, -inf, -4},  // mirrored exponential tail
+        {0, 1, 8, 8.05},      // uniform far in the tail
+        {0, 1, 1.5, 1.6},     // narrow uniform
+    };
+
+    constexpr std::size_t sample_count = 5000;
+
+    // KS test (two-sided, 1%)
+    double const critical_value = 1.63 / std::sqrt(sample_count);
+
+    std::mt19937_64 random{7};
+
+    for (auto const& iv : intervals) {
+        cxx::ziggurat_truncated_normal_distribution<double> dist{iv.mean, iv.stddev, iv.a, iv.b};
+        truncated_normal_cdf const cdf{iv.mean, iv.stddev, iv.a, iv.b};
+
+        std::vector<double> scalar_samples;
+        std::generate_n(std::back_inserter(scalar_samples), sample_count, [&] {
+            return dist(random);
+        });
+
+        std::vector<double> bulk_samples(sample_count);
+        dist.generate(bulk_samples.begin(), bulk_samples.end(), random);
+
+        for (auto const& samples : {scalar_samples, bulk_samples}) {
+            INFO("Interval [" << iv.a << ", " << iv.b << "]");
+            CHECK(*std::min_element(samples.begin(), samples.end()) >= iv.a);
+            CHECK(*std::max_element(samples.begin(), samples.end()) <= iv.b);
+            CHECK(ks_statistic(samples, cdf) < critical_value);
+        }
+    }
+}
+
+TEST_CASE("ziggurat_truncated_normal_distribution - accepts parameters per call")
+{
+    std::mt19937 random;
+    cxx::ziggurat_truncated_normal_distribution<float> dist;
+    cxx::ziggurat_truncated_normal_distribution<float>::param_type const param{0, 1, 5, 6};
+
+    float min = 6;
+    float max = 5;
+    for (int i = 0; i < 1000; i++) {
+        auto const x = dist(random, param);
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+    CHECK(min >= 5);
+    CHECK(max <= 6);
+
+    std::vector<float> samples(1000);
+    dist.generate(samples.begin(), samples.end(), random, param);
+    CHECK(*std::min_element(samples.begin(), samples.end()) >= 5);
+    CHECK(*std::max_element(samples.begin(), samples.end()) <= 6);
+}
+
+TEST_CASE("ziggurat_truncated_normal_distribution - is serializable and deserializable")
+{
+    cxx::ziggurat_truncated_normal_distribution<double> dist_1{1.2, 3.4, -5.6, 7.8};
+    cxx::ziggurat_truncated_normal_distribution<double> dist_2;
+
+    std::stringstream stream;
+    stream << dist_1;
+    stream >> dist_2;
+
+    CHECK(dist_2 == dist_1);
+}
@@ -0,0 +1,105 @@
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include <ziggurat_bank.hpp>
+
+
+namespace
+{
+    void usage()
+    {
+        std::cerr <<
+            "usage: make_noise_bank [-f] [-s seed] [-j threads] count output\n"
+            "\n"
+            "Writes count standard normal random numbers to a noise bank file.\n"
+            "\n"
+            "  -f          write float instead of double\n"
+            "  -s seed     seed of the generator (default: 0)\n"
+            "  -j threads  number of threads (default: hardware concurrency)\n";
+    }
+
+    // parse_number parses the whole string text as a non-negative integer in
+    // decimal, octal or hexadecimal. Returns false if text does not start
+    // with a digit, has trailing characters or is out of range.
+    template<typename T>
+    bool parse_number(char const* text, T& value)
+    {
+        if (!std::isdigit(static_cast<unsigned char>(*text))) {
+            return false;
+        }
+
+        char* end;
+        errno = 0;
+        auto const number = std::strtoull(text, &end, 0);
+        if (end == text || *end != '\0' || errno == ERANGE) {
+            return false;
+        }
+        if (number > std::numeric_limits<T>::max()) {
+            return false;
+        }
+        value = T(number);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool use_float = false;
+    std::uint64_t seed = 0;
+    std::size_t thread_count = 0;
+
+    int argi = 1;
+    for (; argi < argc && argv[argi][0] == '-'; argi++) {
+        std::string const option = argv[argi];
+
+        if (option == "-f") {
+            use_float = true;
+        } else if (option == "-s" && argi + 1 < argc && parse_number(argv[argi + 1], seed)) {
+            argi++;
+        } else if (option == "-j" && argi + 1 < argc && parse_number(argv[argi + 1], thread_count)) {
+            argi++;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    std::uint64_t count = 0;
+    if (argc - argi != 2 || !parse_number(argv[argi], count)) {
+        usage();
+        return 1;
+    }
+
+    std::string const output = argv[argi + 1];
+
+    try {
+        auto const start_time = std::chrono::steady_clock::now();
+
+        if (use_float) {
+            cxx::write_noise_bank<float>(output, count, seed, thread_count);
+        } else {
+            cxx::write_noise_bank<double>(output, count, seed, thread_count);
+        }
+
+        auto const end_time = std::chrono::steady_clock::now();
+        auto const elapsed_time = std::chrono::duration_cast<std::chrono::duration<double>>(
+            end_time - start_time
+        );
+        auto const bytes = double(count * (use_float ? sizeof(float) : sizeof(double)));
+
+        std::cerr
+            << count << " numbers written in " << elapsed_time.count() << " s ("
+            << bytes / elapsed_time.count() * 1e-9 << " GB/s)\n";
+    } catch (std::exception const& e) {
+        std::cerr << "make_noise_bank: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if defined(__has_include) && __cplusplus >= 201703L
+# if __has_include(<charconv>)
+#  include <charconv>
+# endif
+#endif
+
+#include <ziggurat.hpp>
+#include <ziggurat_parallel.hpp>
+
+
+namespace
+{
+    // chunk_size is the number of numbers generated and written at once.
+    constexpr std::size_t chunk_size = 64 * cxx::ziggurat_detail::parallel_block_size;
+
+    // max_text_size is the upper bound of the length of a formatted number
+    // including the trailing newline.
+    constexpr std::size_t max_text_size = 32;
+
+    struct options
+    {
+        std::uint64_t count = 0;
+        double mean = 0;
+        double stddev = 1;
+        std::string engine = "mt19937_64";
+        std::string type = "double";
+        std::uint64_t seed = 0;
+        std::size_t thread_count = 0;
+        bool binary = false;
+        std::string output;
+    };
+
+    void usage()
+    {
+        std::fputs(
+            "usage: zignorm [options] count\n"
+            "\n"
+            "Writes count normal random numbers to stdout or a file.\n"
+            "\n"
+            "  -m mean     mean of the distribution (default: 0)\n"
+            "  -s stddev   standard deviation of the distribution (default: 1)\n"
+            "  -e engine   mt19937_64 (default), mt19937, minstd_rand or ranlux48\n"
+            "  -t type     double (default) or float\n"
+            "  -S seed     seed of the generator (default: 0)\n"
+            "  -j threads  number of threads (default: hardware concurrency)\n"
+            "  -b          write raw binary numbers in native byte order\n"
+            "  -o output   output file (default: stdout)\n",
+            stderr
+        );
+    }
+
+    // format_number writes the shortest text that reads back to x followed
+    // by a newline to out and returns the end of the written text. It falls
+    // back to printing enough digits to round-trip without <charconv>.
+    template<typename T>
+    char* format_number(char* out, T x)
+    {
+#if defined(__cpp_lib_to_chars)
+        out = std::to_chars(out, out + max_text_size - 1, x).ptr;
+#else
+        int const digits = std::numeric_limits<T>::max_digits10;
+        out += std::snprintf(out, max_text_size - 1, "%.*g", digits, double(x));
+#endif
+        *out++ = '\n';
+        return out;
+    }
+
+    // output_file owns the output stream.
+    class output_file
+    {
+    public:
+        explicit output_file(std::string const& path)
+            : file_{path.empty() ? stdout : std::fopen(path.c_str(), "wb")}
+        {
+            if (!file_) {
+                throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+            }
+        }
+
+        output_file(output_file const&) = delete;
+        output_file& operator=(output_file const&) = delete;
+
+        ~output_file()
+        {
+            if (file_ != stdout) {
+                std::fclose(file_);
+            }
+        }
+
+        void write(void const* data, std::size_t size)
+        {
+            if (std::fwrite(data, 1, size, file_) != size) {
+                throw std::system_error(errno, std::generic_category(), "write error");
+            }
+        }
+
+        void flush()
+        {
+            if (std::fflush(file_) != 0) {
+                throw std::system_error(errno, std::generic_category(), "write error");
+            }
+        }
+
+    private:
+        std::FILE* file_;
+    };
+
+    // text_chunk holds the formatted text of the blocks of a chunk.
+    struct text_chunk
+    {
+        std::vector<std::vector<char>> blocks;
+    };
+
+    template<typename T, typename Engine>
+    void generate(options const& opts)
+    {
+        using cxx::ziggurat_detail::parallel_block_size;
+        using param_type = typename cxx::ziggurat_normal_distribution<T>::param_type;
+
+        param_type const param{T(opts.mean), T(opts.stddev)};
+        auto const chunk_count = (opts.count + chunk_size - 1) / chunk_size;
+        auto const thread_count = cxx::ziggurat_detail::resolve_thread_count(
+            opts.thread_count, chunk_size / parallel_block_size
+        );
+
+        output_file output{opts.output};
+
+        auto chunk_length = [&](std::uint64_t chunk) {
+            return std::size_t(std::min<std::uint64_t>(opts.count - chunk * chunk_size, chunk_size));
+        };
+
+        if (opts.binary) {
+            auto produce = [&](std::uint64_t chunk, std::vector<T>& buffer) {
+                buffer.resize(chunk_length(chunk));
+                cxx::ziggurat_detail::fill_parallel_chunk<Engine>(
+                    buffer.data(), chunk * chunk_size, buffer.size(), opts.seed, param, thread_count
+                );
+            };
+            auto consume = [&](std::vector<T> const& buffer) {
+                output.write(buffer.data(), buffer.size() * sizeof(T));
+            };
+            cxx::ziggurat_detail::double_buffered<std::vector<T>>(chunk_count, produce, consume);
+        } else {
+            // Both generation and formatting run in parallel block by block.
+            auto produce = [&](std::uint64_t chunk, text_chunk& buffer) {
+                auto const length = chunk_length(chunk);
+                auto const block_count = (length + parallel_block_size - 1) / parallel_block_size;
+                auto const first_block = std::size_t(chunk * chunk_size / parallel_block_size);
+
+                buffer.blocks.resize(block_count);
+
+                auto format_block = [&](std::size_t block) {
+                    auto const block_begin = block * parallel_block_size;
+                    auto const block_end = std::min(block_begin + parallel_block_size, length);
+
+                    std::vector<T> numbers(block_end - block_begin);
+                    cxx::ziggurat_detail::fill_stream_block<Engine>(
+                        numbers.begin(), numbers.end(), first_block + block, opts.seed, param
+                    );
+
+                    auto& text = buffer.blocks[block];
+                    text.resize(numbers.size() * max_text_size);
+                    char* end = text.data();
+                    for (T const x : numbers) {
+                        end = format_number(end, x);
+                    }
+                    text.resize(std::size_t(end - text.data()));
+                };
+                cxx::ziggurat_detail::run_parallel(
+                    block_count, std::min(thread_count, block_count), format_block
+                );
+            };
+            auto consume = [&](text_chunk const& buffer) {
+                for (auto const& text : buffer.blocks) {
+                    output.write(text.data(), text.size());
+                }
+            };
+            cxx::ziggurat_detail::double_buffered<text_chunk>(chunk_count, produce, consume);
+        }
+
+        output.flush();
+    }
+
+    template<typename T>
+    void generate_with_engine(options const& opts)
+    {
+        if (opts.engine == "mt19937_64") {
+            generate<T, std::mt19937_64>(opts);
+        } else if (opts.engine == "mt19937") {
+            generate<T, std::mt19937>(opts);
+        } else if (opts.engine == "minstd_rand") {
+            generate<T, std::minstd_rand>(opts);
+        } else if (opts.engine == "ranlux48") {
+            generate<T, std::ranlux48>(opts);
+        } else {
+            throw std::invalid_argument("unknown engine: " + opts.engine);
+        }
+    }
+
+    // parse_number parses the whole string text as a floating-point number.
+    // Returns false if text is empty, has trailing characters or is out of
+    // range.
+    bool parse_number(char const* text, double& value)
+    {
+        char* end;
+        errno = 0;
+        value = std::strtod(text, &end);
+        return end != text && *end == '\0' && errno != ERANGE;
+    }
+
+    // parse_number parses the whole string text as a non-negative integer in
+    // decimal, octal or hexadecimal. Returns false if text does not start
+    // with a digit, has trailing characters or is out of range. strtoull
+    // would skip leading spaces and negate "-1" to a huge number.
+    template<typename T>
+    bool parse_number(char const* text, T& value)
+    {
+        if (!std::isdigit(static_cast<unsigned char>(*text))) {
+            return false;
+        }
+
+        char* end;
+        errno = 0;
+        auto const number = std::strtoull(text, &end, 0);
+        if (end == text || *end != '\0' || errno == ERANGE) {
+            return false;
+        }
+        if (number > std::numeric_limits<T>::max()) {
+            return false;
+        }
+        value = T(number);
+        return true;
+    }
+
+    bool parse_options(int argc, char** argv, options& opts)
+    {
+        int argi = 1;
+        for (; argi < argc && argv[argi][0] == '-'; argi++) {
+            std::string const option = argv[argi];
+
+            if (option == "-b") {
+                opts.binary = true;
+                continue;
+            }
+            if (argi + 1 >= argc) {
+                return false;
+            }
+
+            char const* const value = argv[++argi];
+            bool ok = true;
+            if (option == "-m") {
+                ok = parse_number(value, opts.mean);
+            } else if (option == "-s") {
+                ok = parse_number(value, opts.stddev);
+            } else if (option == "-e") {
+                opts.engine = value;
+            } else if (option == "-t") {
+                opts.type = value;
+            } else if (option == "-S") {
+                ok = parse_number(value, opts.seed);
+            } else if (option == "-j") {
+                ok = parse_number(value, opts.thread_count);
+            } else if (option == "-o") {
+                opts.output = value;
+            } else {
+                return false;
+            }
+            if (!ok) {
+                std::fprintf(stderr, "zignorm: invalid value for %s: '%s'\n", option.c_str(), value);
+                return false;
+            }
+        }
+
+        if (argc - argi != 1) {
+            return false;
+        }
+        if (!parse_number(argv[argi], opts.count)) {
+            std::fprintf(stderr, "zignorm: invalid count: '%s'\n", argv[argi]);
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    options opts;
+    if (!parse_options(argc, argv, opts)) {
+        usage();
+        return 1;
+    }
+
+    try {
+        if (opts.type == "double") {
+            generate_with_engine<double>(opts);
+        } else if (opts.type == "float") {
+            generate_with_engine<float>(opts);
+        } else {
+            throw std::invalid_argument("unknown type: " + opts.type);
+        }
+    } catch (std::exception const& e) {
+        std::fprintf(stderr, "zignorm: %s\n", e.what());
+        return 1;
+    }
+}